@@ -44,16 +44,25 @@
 
 //Module
 #include "errors.h"
+#include "json_data_buffer.h"
 #include "curl_lib.h"
 
 /* ***************************   Definitions   **************************** */
 
 /* ****************************   Structures   **************************** */
 
+// Passed through libcurl to the streaming write callback
+typedef struct
+{
+    curlLibChunkCbk_t *p_chunk_cbk;
+    void *p_ctx;
+} curlLibStreamCtx_t;
+
 /* ***********************   Function Prototypes   ************************ */
 
 static size_t curlLibStoreJsonDataCbk(void *ptr, size_t size, size_t nmemb, void *stream);
 static size_t curlLibStdOutCbk(void* ptr, size_t size, size_t nmemb, void* userdata);
+static size_t curlLibStreamCbk(void *ptr, size_t size, size_t nmemb, void *userdata);
 
 /* ***********************   File Scope Variables   *********************** */
 
@@ -65,6 +74,7 @@ static size_t curlLibStdOutCbk(void* ptr, size_t size, size_t nmemb, void* userd
 void curlLibInit(void)
 {
     curl_global_init(CURL_GLOBAL_DEFAULT);
+    jsonBufferInit();
 }
 
 // Initializes an HTTP buffer
@@ -74,7 +84,7 @@ void curlLibBufferInit(httpDataBuffer_t *const p_buff)
 }
 
 // Makes an HTTP request and retuns a payload from that URI
-// Buffer is dynamically allocated and passed back to the caller.
+// Buffer is taken from the buffer pool and passed back to the caller, it goes back to the pool with curlLibFreeData().
 appErrors_t curlLibGetData(httpDataBuffer_t *const p_buffer, const char *const url)
 {
     appErrors_t result = APPERR_OK;
@@ -101,25 +111,21 @@ appErrors_t curlLibGetData(httpDataBuffer_t *const p_buffer, const char *const u
                 // Check to see if size buffer is large enough to hold the JSON data
                 if ((int)p_buffer->size < dl_size)
                 {
-                    // Free existing and malloc a larger buffer size before download
-                    if (p_buffer->p_buffer != NULL)
-                    {
-                        free(p_buffer->p_buffer);
-                        p_buffer->size = 0;
-                    }
-
-                    // Malloc a new buffer
-                    p_buffer->p_buffer = malloc((size_t)dl_size);
-
-                    if (p_buffer->p_buffer != NULL)
-                    {
-                        // Set position to start and size to the malloc'd size
-                        p_buffer->p_pos = p_buffer->p_buffer;
-                        p_buffer->size = dl_size;
-                    }
-                    else
+                    // Trade the existing buffer for a larger one from the pool before download
+                    jsonDataBuffer_t data_buff = {.p_buff = p_buffer->p_buffer, .size = (int)p_buffer->size,
+                                                  .id = p_buffer->buffer_id};
+                    jsonBufferReturnBuffer(&data_buff);
+                    jsonBufferGetBuffer(&data_buff, (int)dl_size);
+
+                    // Set position to start and size to the size of the pooled buffer, which can be larger
+                    p_buffer->p_buffer = data_buff.p_buff;
+                    p_buffer->p_pos = p_buffer->p_buffer;
+                    p_buffer->size = (size_t)data_buff.size;
+                    p_buffer->buffer_id = data_buff.id;
+
+                    if (p_buffer->p_buffer == NULL)
                     {
-                        // malloc failed
+                        // Allocation failed
                         result = APPERR_UNABLE_TO_ALLOCATE_MEMORY;
                     }
                 }
@@ -150,10 +156,38 @@ appErrors_t curlLibGetData(httpDataBuffer_t *const p_buffer, const char *const u
     return result;
 }
 
-// Frees the buffer object after it has served it's purpose
+// Returns the buffer object to the pool after it has served it's purpose
 void curlLibFreeData(const httpDataBuffer_t *const p_buffer)
 {
-    free(p_buffer->p_buffer);
+    jsonDataBuffer_t data_buff = {.p_buff = p_buffer->p_buffer, .size = (int)p_buffer->size, .id = p_buffer->buffer_id};
+    jsonBufferReturnBuffer(&data_buff);
+}
+
+// Makes an HTTP request and hands the payload to the callback as it arrives, chunk by chunk.
+// Nothing is buffered, so the payload is only downloaded once and can be of any size.
+appErrors_t curlLibStreamData(const char *const url, curlLibChunkCbk_t *const p_chunk_cbk, void *const p_ctx)
+{
+    appErrors_t result = APPERR_JSON_DATA_UNABLE_TO_BE_RETRIVED;
+    CURL *curl_handle = curl_easy_init();
+
+    if (curl_handle != NULL)
+    {
+        curlLibStreamCtx_t stream_ctx = {.p_chunk_cbk = p_chunk_cbk, .p_ctx = p_ctx};
+        curl_easy_setopt(curl_handle, CURLOPT_URL, url);
+        curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, &stream_ctx);
+        curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, curlLibStreamCbk);
+
+        // If the callback aborts, the transfer fails with CURLE_WRITE_ERROR
+        if (curl_easy_perform(curl_handle) == CURLE_OK)
+        {
+            result = APPERR_OK;
+        }
+
+        // Clean-up after operation complete
+        curl_easy_cleanup(curl_handle);
+    }
+
+    return result;
 }
 
 /* *************************   Private Functions   ************************ */
@@ -173,6 +207,17 @@ static size_t curlLibStoreJsonDataCbk(void *ptr, size_t size, size_t nmemb, void
     return num_bytes_to_copy;
 }
 
+// Write callback for libcUrl when streaming
+// Forwards the data to the stream's chunk callback
+static size_t curlLibStreamCbk(void *ptr, size_t size, size_t nmemb, void *userdata)
+{
+    const curlLibStreamCtx_t *const p_stream_ctx = (const curlLibStreamCtx_t *)userdata;
+    const size_t num_bytes = (size * nmemb);
+
+    // Handling less than the number of bytes passed in tells curl to abort
+    return (p_stream_ctx->p_chunk_cbk(p_stream_ctx->p_ctx, (const char *)ptr, num_bytes) ? num_bytes : 0);
+}
+
 // This callback just sends data to standard out
 static size_t curlLibStdOutCbk(void* ptr, size_t size, size_t nmemb, void* userdata)
 {
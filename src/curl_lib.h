@@ -35,12 +35,18 @@
 
 /* ***************************    Includes     **************************** */
 
+#include <stdbool.h>
+#include <stddef.h>
+
 // Include for the error return type
 #include "errors.h"
 #include "shared_data_types.h"
 
 /* ***************************   Definitions   **************************** */
 
+// Called with each chunk of data as it is received when streaming. Return false to abort the transfer.
+typedef bool (curlLibChunkCbk_t)(void *p_ctx, const char *const p_chunk, const size_t chunk_len);
+
 /* ****************************   Structures   **************************** */
 
 
@@ -50,5 +56,6 @@ void curlLibInit(void);
 void curlLibBufferInit(httpDataBuffer_t *const p_buff);
 appErrors_t curlLibGetData(httpDataBuffer_t *const p_buffer, const char *const url);
 void curlLibFreeData(const httpDataBuffer_t *const p_buffer);
+appErrors_t curlLibStreamData(const char *const url, curlLibChunkCbk_t *const p_chunk_cbk, void *const p_ctx);
 
 #endif /* CURL_LIB_H */
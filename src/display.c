@@ -44,6 +44,8 @@
 
 // Project Includes
 #include "game_data_parser.h"
+#include "game_data_feed.h"
+#include "json_data_buffer.h"
 
 // Module Includes
 #include "display/text.h"
@@ -59,6 +61,13 @@
 #define DISPLAY_BACKGROUND_FILE "res/1.jpg"
 #define DISPLAY_LOADING_IMAGE_FILE "res/loading.png"
 
+// Game data shown, gathered again every DISPLAY_GAME_DATA_REFRESH_MS while the window is open
+#define DISPLAY_GAME_DATA_URL "http://statsapi.mlb.com/api/v1/schedule?hydrate=game(content(editorial(recap))),decisions&date=2018-06-10&sportId=1"
+#define DISPLAY_GAME_DATA_REFRESH_MS (60 * 1000)
+
+// The render loop is the only reader of the game data feed
+#define DISPLAY_FEED_READER_IDX 0
+
 // Screen dimension constants
 #define DISPLAY_SCREEN_WIDTH 1920
 #define DISPLAY_SCREEN_HEIGHT 1080
@@ -188,27 +197,50 @@ static void displayStartDisplay(void)
     SDL_RenderClear(g_renderer);
     drawableObj_t background = imgInitObjFile(0, 0, DISPLAY_BACKGROUND_FILE);
     drawableObj_t loading = imgInitObjFile(0, 0, DISPLAY_LOADING_IMAGE_FILE);
-    background.draw(&background, 0, 0, 0, 0, g_renderer);
-    loading.draw(&loading, 0, 0, 0, 0, g_renderer);
-    SDL_RenderPresent(g_renderer);
 
-    // Download the data
-    // TODO: make this a separate thread, so the SDL code can continue on and window stays responsive
-    //
+    // The data is downloaded, and refreshed, on the feed's own thread, so the window stays responsive
     // TODO: Take the URL in as a param
-    gameDataNode_t *p_game_list =
-        gameDataParserGatherData("http://statsapi.mlb.com/api/v1/schedule?hydrate=game(content(editorial(recap))),decisions&date=2018-06-10&sportId=1");
+    gameDataFeed_t game_data_feed;
+    gameDataFeedInit(&game_data_feed, DISPLAY_GAME_DATA_URL, DISPLAY_GAME_DATA_REFRESH_MS);
+    if (!gameDataFeedStart(&game_data_feed))
+    {
+        // Without the feed's thread the data is gathered once, here, and never refreshed
+        printf("Game data will not be refreshed\n");
+        background.draw(&background, 0, 0, 0, 0, g_renderer);
+        loading.draw(&loading, 0, 0, 0, 0, g_renderer);
+        SDL_RenderPresent(g_renderer);
 
-    // Done loading, init the game list and hold onto the event handler
-    displayEventHandlerFcn_t *gameDispEvntHandler = gameDisplayInit(p_game_list);
+        gameDataFeedRefresh(&game_data_feed);
+    }
+
+    // Event handler of the game list, once there is one
+    displayEventHandlerFcn_t *gameDispEvntHandler = NULL;
+    int displayed_version = 0;
 
     // Start polling events
     SDL_Event event;
     bool exit = false;
     while (!exit)
     {
+        // Move on to the latest game data, the game list is rebuilt whenever it changes. The data stays valid
+        // until the next frame moves on again, the feed never makes the frame wait.
+        const gameDataSnapshot_t *p_snapshot = gameDataFeedReadLock(&game_data_feed, DISPLAY_FEED_READER_IDX);
+        if ((p_snapshot != NULL) && (p_snapshot->version != displayed_version))
+        {
+            gameDispEvntHandler = gameDisplayInit(&p_snapshot->list);
+            displayed_version = p_snapshot->version;
+        }
+
         background.draw(&background, 0, 0, 0, 0, g_renderer);
-        gameDisplayGames(g_renderer);
+        if (gameDispEvntHandler != NULL)
+        {
+            gameDisplayGames(g_renderer);
+        }
+        else
+        {
+            // Still loading
+            loading.draw(&loading, 0, 0, 0, 0, g_renderer);
+        }
 
         SDL_RenderPresent(g_renderer);
 
@@ -218,8 +250,6 @@ static void displayStartDisplay(void)
             {
             case SDL_QUIT:
                 exit = true;
-                // No longer need the game list, so it can be free'd
-                gameDataParserGameListDestroy(p_game_list);
                 break;
 
             case SDL_KEYDOWN:
@@ -231,12 +261,22 @@ static void displayStartDisplay(void)
             }
 
             // Call other event handlers
-            gameDispEvntHandler(&event);
+            if (gameDispEvntHandler != NULL)
+            {
+                gameDispEvntHandler(&event);
+            }
 
         }
 
         SDL_RenderClear(g_renderer);
     }
+
+    // No longer need the game list or the feed, so they can be free'd. The game list points into the game data,
+    // it goes first. Stopping the feed waits for a refresh that is under way.
+    gameDisplayDestroy();
+    gameDataFeedReadUnlock(&game_data_feed, DISPLAY_FEED_READER_IDX);
+    gameDataFeedDestroy(&game_data_feed);
+    jsonBufferRelease();
 }
 
 
@@ -72,114 +72,141 @@
 #define UNSELECTED_IMAGE_SIZE_W 360
 #define UNSELECTED_IMAGE_SIZE_H 202
 
+// Scores below this are formatted once, the first time a game needs them, and the text is shared by every game
+#define SCORE_TEXT_CACHE_SIZE 100
+
 /* ****************************   Structures   **************************** */
 
 typedef struct
 {
     int pos_x;
     int pos_y;
-    bool selected;
     int score_offset;
     drawableObj_t date;
+
+    // Team names and the game state are shared with the games that have the same text, see gameDisplayList_t.
+    // They point to the game's own drawables below when the text isn't interned.
+    drawableObj_t *p_game_state;
+    drawableObj_t *p_home_team_name;
+    drawableObj_t *p_away_team_name;
     drawableObj_t game_state;
     drawableObj_t home_team_name;
     drawableObj_t away_team_name;
+
     drawableObj_t home_team_score;
     drawableObj_t away_team_score;
     drawableObj_t thumb;
-} gameDisplayObj_t;
 
+    // Text of scores too large for the score cache
+    char home_team_score_text[MAX_UINT32_STR_LEN];
+    char away_team_score_text[MAX_UINT32_STR_LEN];
+} gameDisplayObj_t;
 
-typedef struct gameDisplayNode gameDisplayNode_t;
 
-// Linked list node
-struct gameDisplayNode
+// Display objects of every game, in the same order as the list of games
+typedef struct
 {
-    gameDisplayNode_t *next;
-    gameDisplayNode_t *prev;
-    gameDisplayObj_t *p_data;
-};
+    gameDisplayObj_t *p_objs;
+    int num_objs;
+    int selected_idx;   // Game displayed in the middle
+
+    // Text drawables indexed by the intern id of their text, so games with the same text share a texture
+    drawableObj_t *p_shared_text;
+    int num_shared_text;
+} gameDisplayList_t;
 
 
 
 /* ***********************   Function Prototypes   ************************ */
 
-static void gameDisplayGame(SDL_Renderer *renderer, gameDisplayObj_t *game);
+static void gameDisplayGame(SDL_Renderer *renderer, gameDisplayObj_t *game, const bool selected);
 
 static void gameDisplayEventHandler(const SDL_Event *p_event);
 
-static const gameDisplayNode_t *gameFindSelectedNode(const gameDisplayNode_t *p_node_list);
-
-static gameDisplayNode_t *gameDisplayObjListCreate(const gameDataNode_t *p_node);
-static void gameDisplayObjListDestroy(const gameDisplayNode_t *p_node);
+static void gameDisplayObjListCreate(gameDisplayList_t *const p_list, const gameDataList_t *const p_game_list);
+static void gameDisplayObjListDestroy(gameDisplayList_t *const p_list);
 
-static gameDisplayObj_t *gameDisplayObjCreate(const gameData_t *p_game_data);
-static gameDisplayObjDestroy(gameDisplayObj_t *p_obj);
+static void gameDisplayObjInit(gameDisplayList_t *const p_list, gameDisplayObj_t *const p_game, const gameData_t *p_game_data);
+static drawableObj_t *gameDisplayTextObj(gameDisplayList_t *const p_list, drawableObj_t *const p_own_obj,
+                                         const gameDataStr_t *const p_text);
+static const char *gameDisplayScoreText(const uint32_t score, char *const p_own_text);
 
 /* ***********************   File Scope Variables   *********************** */
 
 // Holds the single instance of game display structs
-static gameDisplayNode_t *g_game_object_list = NULL;
+static gameDisplayList_t g_game_object_list = {.p_objs = NULL, .num_objs = 0, .selected_idx = 0,
+                                               .p_shared_text = NULL, .num_shared_text = 0};
+
+// Text of the small scores, indexed by score. Empty until a game needs it.
+static char g_score_text[SCORE_TEXT_CACHE_SIZE][MAX_UINT32_STR_LEN];
 
 /* *************************   Public  Functions   ************************ */
 
-// Creates the game list
-displayEventHandlerFcn_t *gameDisplayInit(const gameDataNode_t *p_node)
+// Creates the game list, replacing the current one (i.e. when the game data is refreshed). The selected game stays
+// selected, as far as the new list allows.
+// NOTE: The games must not be freed until the list is replaced or destroyed, the display objects point into them
+displayEventHandlerFcn_t *gameDisplayInit(const gameDataList_t *p_game_list)
 {
-    // TODO: This is a cop-out. This should function should destroy the current list and recreate it.
-    // TODO: Time permitting, come back and fix this.
-    assert(g_game_object_list == NULL);
+    const int selected_idx = g_game_object_list.selected_idx;
+    gameDisplayObjListDestroy(&g_game_object_list);
 
-    g_game_object_list = gameDisplayObjListCreate(p_node);
+    gameDisplayObjListCreate(&g_game_object_list, p_game_list);
+    g_game_object_list.selected_idx = MAX(0, min(selected_idx, (g_game_object_list.num_objs - 1)));
     return gameDisplayEventHandler;
 }
 
+// Destroys the game list, and the textures of its games
+void gameDisplayDestroy(void)
+{
+    gameDisplayObjListDestroy(&g_game_object_list);
+}
+
 
 //
 void gameDisplayGames(SDL_Renderer *renderer)
 {
-    assert(g_game_object_list != NULL && renderer != NULL);
+    assert(renderer != NULL);
 
-    int width;
-    int height;
-    SDL_GetRendererOutputSize(renderer, &width, &height);
+    // Nothing to display without any games
+    if(g_game_object_list.num_objs > 0)
+    {
+        int width;
+        int height;
+        SDL_GetRendererOutputSize(renderer, &width, &height);
 
-    // Get the selected node
-    const gameDisplayNode_t *p_selected_node = gameFindSelectedNode(g_game_object_list);
+        gameDisplayObj_t *p_objs = g_game_object_list.p_objs;
+        const int selected_idx = g_game_object_list.selected_idx;
 
-    // Current node displayed in the middle
-    int starting_x_coord = (width / 2) - (SELECTED_IMAGE_SIZE_W / 2);
-    int y_coord = (height / 2) - (SELECTED_IMAGE_SIZE_H / 2);
-    p_selected_node->p_data->pos_x = starting_x_coord;
-    p_selected_node->p_data->pos_y = y_coord;
+        // Selected game displayed in the middle
+        int starting_x_coord = (width / 2) - (SELECTED_IMAGE_SIZE_W / 2);
+        int y_coord = (height / 2) - (SELECTED_IMAGE_SIZE_H / 2);
+        p_objs[selected_idx].pos_x = starting_x_coord;
+        p_objs[selected_idx].pos_y = y_coord;
 
-    gameDisplayGame(renderer, p_selected_node->p_data);
+        gameDisplayGame(renderer, &p_objs[selected_idx], true);
 
-    // Change y for non-selected games
-    y_coord = (height / 2) - (UNSELECTED_IMAGE_SIZE_H / 2);
+        // Change y for non-selected games
+        y_coord = (height / 2) - (UNSELECTED_IMAGE_SIZE_H / 2);
 
-    // Previous nodes will be displayed to the left
-    const gameDisplayNode_t *p_current_node = p_selected_node;
-    int next_x_coord = starting_x_coord - (UNSELECTED_IMAGE_SIZE_W + GAME_SPACING);
-    while(p_current_node->prev != NULL)
-    {
-        p_current_node->prev->p_data->pos_x = next_x_coord;
-        p_current_node->prev->p_data->pos_y = y_coord;
-        gameDisplayGame(renderer, p_current_node->prev->p_data);
-        p_current_node = p_current_node->prev;
-        next_x_coord -= UNSELECTED_IMAGE_SIZE_W + GAME_SPACING;
-    }
+        // Previous games will be displayed to the left
+        int next_x_coord = starting_x_coord - (UNSELECTED_IMAGE_SIZE_W + GAME_SPACING);
+        for(int idx = (selected_idx - 1); idx >= 0; idx--)
+        {
+            p_objs[idx].pos_x = next_x_coord;
+            p_objs[idx].pos_y = y_coord;
+            gameDisplayGame(renderer, &p_objs[idx], false);
+            next_x_coord -= UNSELECTED_IMAGE_SIZE_W + GAME_SPACING;
+        }
 
-    // Next nodes will displayed to the right
-    p_current_node = p_selected_node;
-    next_x_coord = starting_x_coord + (SELECTED_IMAGE_SIZE_W + GAME_SPACING);
-    while(p_current_node->next != NULL)
-    {
-        p_current_node->next->p_data->pos_x = next_x_coord;
-        p_current_node->next->p_data->pos_y = y_coord;
-        gameDisplayGame(renderer, p_current_node->next->p_data);
-        p_current_node = p_current_node->next;
-        next_x_coord += UNSELECTED_IMAGE_SIZE_W + GAME_SPACING;
+        // Next games will displayed to the right
+        next_x_coord = starting_x_coord + (SELECTED_IMAGE_SIZE_W + GAME_SPACING);
+        for(int idx = (selected_idx + 1); idx < g_game_object_list.num_objs; idx++)
+        {
+            p_objs[idx].pos_x = next_x_coord;
+            p_objs[idx].pos_y = y_coord;
+            gameDisplayGame(renderer, &p_objs[idx], false);
+            next_x_coord += UNSELECTED_IMAGE_SIZE_W + GAME_SPACING;
+        }
     }
 }
 
@@ -198,23 +225,15 @@ static void gameDisplayEventHandler(const SDL_Event *p_event)
         switch (p_event->key.keysym.sym)
         {
         case SDLK_RIGHT:
+            if(g_game_object_list.selected_idx < (g_game_object_list.num_objs - 1))
             {
-                gameDisplayNode_t *p_node = gameFindSelectedNode(g_game_object_list)->next;
-                if(p_node != NULL)
-                {
-                    p_node->p_data->selected = true;
-                    p_node->prev->p_data->selected = false;
-                }
+                g_game_object_list.selected_idx++;
             }
             break;
         case SDLK_LEFT:
+            if(g_game_object_list.selected_idx > 0)
             {
-                gameDisplayNode_t *p_node = gameFindSelectedNode(g_game_object_list)->prev;
-                if(p_node != NULL)
-                {
-                    p_node->p_data->selected = true;
-                    p_node->next->p_data->selected = false;
-                }
+                g_game_object_list.selected_idx--;
             }
             break;
 
@@ -224,80 +243,69 @@ static void gameDisplayEventHandler(const SDL_Event *p_event)
     }
 }
 
-// Given a linked list of game data nodes, a linked list of game display objects will be created
-// NOTE: The first game data node should be passed in
-static gameDisplayNode_t *gameDisplayObjListCreate(const gameDataNode_t *p_node)
+// Given a list of games, a display object is created for each game, the first one is selected
+static void gameDisplayObjListCreate(gameDisplayList_t *const p_list, const gameDataList_t *const p_game_list)
 {
-    // Ensure the passed in node is the first node
-    assert(p_node->prev == NULL);
+    p_list->p_objs = (p_game_list->num_games > 0) ? malloc(p_game_list->num_games * sizeof(gameDisplayObj_t)) : NULL;
+    p_list->num_objs = (p_list->p_objs != NULL) ? p_game_list->num_games : 0;
+    p_list->selected_idx = 0;
 
-    gameDisplayNode_t *p_list = NULL;
-
-    const gameDataNode_t *curr_data_node = p_node;
-    bool malloc_fail = false;
-    while(curr_data_node != NULL && !malloc_fail)
+    // Room for every interned text of the games, ids are numbered from 0
+    int max_intern_id = GAME_DATA_STR_NOT_INTERNED;
+    for(int idx = 0; idx < p_list->num_objs; idx++)
     {
-        gameDisplayNode_t *curr_disp_node = malloc(sizeof(gameDisplayNode_t));
-        if(curr_disp_node != NULL)
-        {
-            // Clear out the data space
-            memset(curr_disp_node, 0, sizeof(gameDisplayNode_t));
-
-            // Link the previous node to the last one created (even if it's the first one)
-            // as long as p_list is set to NULL, this is fine
-            curr_disp_node->prev = p_list;
-
-            curr_disp_node->p_data = gameDisplayObjCreate(curr_data_node->p_data);
-            if(curr_disp_node->p_data == NULL)
-            {
-                malloc_fail = true;
-            }
-        }
-        else
-        {
-            malloc_fail = true;
-        }
-
-        // If not the first node created, link them up
-        if(p_list != NULL)
-        {
-            p_list->next = curr_disp_node;
-        }
-
-        // Advance to the next nodes
-        p_list = curr_disp_node;
-        curr_data_node = curr_data_node->next;
+        const gameData_t *const p_game_data = &p_game_list->p_games[idx];
+        max_intern_id = MAX(max_intern_id, p_game_data->detailed_state_str.intern_id);
+        max_intern_id = MAX(max_intern_id, p_game_data->home_team_name_str.intern_id);
+        max_intern_id = MAX(max_intern_id, p_game_data->away_team_name_str.intern_id);
     }
+    p_list->p_shared_text = (max_intern_id >= 0) ? calloc((max_intern_id + 1), sizeof(drawableObj_t)) : NULL;
+    p_list->num_shared_text = (p_list->p_shared_text != NULL) ? (max_intern_id + 1) : 0;
 
-    if(malloc_fail)
+    for(int idx = 0; idx < p_list->num_objs; idx++)
     {
-        // TODO: Handle the malloc failure by traversing to the beginning of the list
-        // TODO: and freeing the data and the nodes
-
-        p_list = NULL;
+        gameDisplayObjInit(p_list, &p_list->p_objs[idx], &p_game_list->p_games[idx]);
     }
+}
 
-    // Return the first item in the list
-    while (p_list != NULL && p_list->prev != NULL)
+// Destroys the list of Game Display Objects, along with their textures
+static void gameDisplayObjListDestroy(gameDisplayList_t *const p_list)
+{
+    for(int idx = 0; idx < p_list->num_objs; idx++)
     {
-        p_list = p_list->prev;
+        gameDisplayObj_t *const p_game = &p_list->p_objs[idx];
+        textDestroyObj(&p_game->date);
+        textDestroyObj(&p_game->home_team_score);
+        textDestroyObj(&p_game->away_team_score);
+        imgDestroyObj(&p_game->thumb);
+
+        // Shared text is destroyed once, below
+        drawableObj_t *const p_own_text[] = {&p_game->game_state, &p_game->home_team_name, &p_game->away_team_name};
+        const drawableObj_t *const p_text[] = {p_game->p_game_state, p_game->p_home_team_name, p_game->p_away_team_name};
+        for(int text_idx = 0; text_idx < (int)ARRAY_SIZE(p_own_text); text_idx++)
+        {
+            if(p_text[text_idx] == p_own_text[text_idx])
+            {
+                textDestroyObj(p_own_text[text_idx]);
+            }
+        }
     }
 
-    return p_list;
-}
-
-// Destroys the list of Game Display Objects
-static void gameDisplayObjListDestroy(const gameDisplayNode_t *p_node)
-{
-    const gameDisplayNode_t *p_current_node = p_node;
-    while(p_current_node != NULL)
+    for(int idx = 0; idx < p_list->num_shared_text; idx++)
     {
-        gameDisplayObjDestroy(p_current_node->p_data);
-        const gameDisplayNode_t *p_next_node = p_current_node->next;
-        // Safe cast, since we intend to free the data
-        free((void *)p_current_node);
-        p_current_node = p_next_node;
+        if(p_list->p_shared_text[idx].type == E_DRAWABLE_TEXT)
+        {
+            textDestroyObj(&p_list->p_shared_text[idx]);
+        }
     }
+
+    free(p_list->p_objs);
+    free(p_list->p_shared_text);
+    p_list->p_objs = NULL;
+    p_list->num_objs = 0;
+    p_list->selected_idx = 0;
+    p_list->p_shared_text = NULL;
+    p_list->num_shared_text = 0;
 }
 
 // Displays a game on the screen, based on a gameDisplayObj_t
@@ -306,14 +314,14 @@ static void gameDisplayObjListDestroy(const gameDisplayNode_t *p_node)
 // TODO: types and iterate through to "draw a game". The only seemingly tricky part is the x
 // TODO: offset for the scores, which is dynamic. Possibly a "getXOffset" function that could
 // TODO: recognize the element and return the proper x offset.
-static void gameDisplayGame(SDL_Renderer *renderer, gameDisplayObj_t *game)
+static void gameDisplayGame(SDL_Renderer *renderer, gameDisplayObj_t *game, const bool selected)
 {
     assert(game != NULL && renderer != NULL);
 
     int x = game->pos_x;
     int y = game->pos_y;
 
-    if(game->selected)
+    if(selected)
     {
         // Display image
         game->thumb.draw(&game->thumb, x, y, SELECTED_IMAGE_SIZE_W, SELECTED_IMAGE_SIZE_H, renderer);
@@ -325,13 +333,13 @@ static void gameDisplayGame(SDL_Renderer *renderer, gameDisplayObj_t *game)
         y += SELECTED_IMAGE_SIZE_H + VERTICAL_BUFFER_AROUND_IMG;
 
         int score_offset = game->score_offset;
-        game->home_team_name.draw(&game->home_team_name, x, y, 0, 0, renderer);
+        game->p_home_team_name->draw(game->p_home_team_name, x, y, 0, 0, renderer);
         game->home_team_score.draw(&game->home_team_score, x + (SELECTED_IMAGE_SIZE_W - score_offset), y, 0, 0, renderer);
         y += (VERTICAL_TEXT_OFFSET);
-        game->away_team_name.draw(&game->away_team_name, x, y, 0, 0, renderer);
+        game->p_away_team_name->draw(game->p_away_team_name, x, y, 0, 0, renderer);
         game->away_team_score.draw(&game->away_team_score, x + (SELECTED_IMAGE_SIZE_W - score_offset), y, 0, 0, renderer);
         y += (VERTICAL_TEXT_OFFSET);
-        game->game_state.draw(&game->game_state, x, y, 0, 0, renderer);
+        game->p_game_state->draw(game->p_game_state, x, y, 0, 0, renderer);
     }
     else
     {
@@ -342,68 +350,70 @@ static void gameDisplayGame(SDL_Renderer *renderer, gameDisplayObj_t *game)
 }
 
 
-// Finds the selected node in the linked list and returns it
-// If NO nodes are selected, then it returns the first one and marks it selected
-static const gameDisplayNode_t *gameFindSelectedNode(const gameDisplayNode_t *p_node_list)
+// Creates the drawable objects of a game
+static void gameDisplayObjInit(gameDisplayList_t *const p_list, gameDisplayObj_t *const p_game, const gameData_t *p_game_data)
 {
-    // Find selected game, if none are selected, just use the first one
-    const gameDisplayNode_t *p_selected_node = p_node_list;
-    const gameDisplayNode_t *p_current_node = p_node_list;
-    bool found_selected = false;
-    while(p_current_node != NULL && !found_selected)
+    int x = 0;
+    int y = 0;
+    p_game->pos_x =x;
+    p_game->pos_y =y;
+
+    p_game->date = textInitObj(p_game_data->date_str, NORMAL_FONT_SIZE, x, y);
+
+    // A game whose image could not be downloaded is drawn without it
+    const httpDataBuffer_t *const p_img_data = p_game_data->p_img_data;
+    p_game->thumb = imgInitObjBuff(x, y, ((p_img_data != NULL) ? (const uint8_t *)p_img_data->p_buffer : NULL),
+                                   ((p_img_data != NULL) ? p_img_data->content_length : 0));
+    // Create other text elements
+    p_game->p_game_state = gameDisplayTextObj(p_list, &p_game->game_state, &p_game_data->detailed_state_str);
+    p_game->p_home_team_name = gameDisplayTextObj(p_list, &p_game->home_team_name, &p_game_data->home_team_name_str);
+    p_game->p_away_team_name = gameDisplayTextObj(p_list, &p_game->away_team_name, &p_game_data->away_team_name_str);
+
+    // Scores are numbers in the game data, they are only turned into text here
+    const char *const p_home_score = gameDisplayScoreText(p_game_data->home_team_score, p_game->home_team_score_text);
+    const char *const p_away_score = gameDisplayScoreText(p_game_data->away_team_score, p_game->away_team_score_text);
+    const size_t home_score_len = strlen(p_home_score);
+    const size_t away_score_len = strlen(p_away_score);
+    p_game->score_offset = (int)(MAX(home_score_len, away_score_len) * PIX_PER_CHAR);
+    p_game->home_team_score = textInitObj(p_home_score, NORMAL_FONT_SIZE, x, y);
+    p_game->away_team_score = textInitObj(p_away_score, NORMAL_FONT_SIZE, x, y);
+}
+
+// Gets the text drawable of a game. Interned text is drawn with the list's drawable for it, created by the first game
+// with the text, so its texture is only rendered once. Any other text gets a drawable of the game's own, in `p_own_obj`.
+static drawableObj_t *gameDisplayTextObj(gameDisplayList_t *const p_list, drawableObj_t *const p_own_obj,
+                                         const gameDataStr_t *const p_text)
+{
+    drawableObj_t *p_obj = p_own_obj;
+    if((p_text->intern_id >= 0) && (p_text->intern_id < p_list->num_shared_text))
     {
-        if(p_current_node->p_data->selected)
-        {
-            found_selected = true;
-            p_selected_node = p_current_node;
-        }
-        else
-        {
-            p_current_node = p_current_node->next;
-        }
+        p_obj = &p_list->p_shared_text[p_text->intern_id];
     }
 
-    // Reached the end w/o finding a selected node
-    if(!found_selected)
+    // Shared drawables start out zeroed (E_DRAWABLE_INVALID)
+    if((p_obj == p_own_obj) || (p_obj->type == E_DRAWABLE_INVALID))
     {
-        // In this case, selected node's selected variable isn't actually set, go ahead and set it
-        p_selected_node->p_data->selected = true;
+        *p_obj = textInitObj(p_text->str, NORMAL_FONT_SIZE, 0, 0);
     }
 
-    return p_selected_node;
+    return p_obj;
 }
 
-
-static gameDisplayObj_t *gameDisplayObjCreate(const gameData_t *p_game_data)
+// Gets the text of a score. Small scores come out of the score cache, formatted the first time they are needed,
+// larger ones are formatted into `p_own_text` (MAX_UINT32_STR_LEN characters).
+static const char *gameDisplayScoreText(const uint32_t score, char *const p_own_text)
 {
-    gameDisplayObj_t *p_game = malloc(sizeof(gameDisplayObj_t));
-
-    if(p_game!= NULL)
+    char *p_text = p_own_text;
+    if(score < SCORE_TEXT_CACHE_SIZE)
     {
-        int x = 0;
-        int y = 0;
-        p_game->pos_x =x;
-        p_game->pos_y =y;
-        p_game->selected = false;
-        p_game->score_offset = (int)(MAX(strlen(p_game_data->home_team_score_str), strlen(p_game_data->away_team_score_str)) * PIX_PER_CHAR);
-
-        p_game->date = textInitObj(p_game_data->date_str, NORMAL_FONT_SIZE, x, y);
-
-        p_game->thumb = imgInitObjBuff(x, y, p_game_data->p_img_data->p_buffer, p_game_data->p_img_data->content_length);
-        // Create other text elements
-        p_game->game_state = textInitObj(p_game_data->detailed_state_str, NORMAL_FONT_SIZE, x, y);
-        p_game->home_team_name = textInitObj(p_game_data->home_team_name_str, NORMAL_FONT_SIZE, x, y);
-        p_game->away_team_name = textInitObj(p_game_data->away_team_name_str, NORMAL_FONT_SIZE, x, y);
-        p_game->home_team_score = textInitObj(p_game_data->home_team_score_str, NORMAL_FONT_SIZE, x, y);
-        p_game->away_team_score = textInitObj(p_game_data->away_team_score_str, NORMAL_FONT_SIZE, x, y);
+        p_text = g_score_text[score];
     }
 
-    return p_game;
-}
-
-
+    // Cached text is empty until it is first formatted, and never changes after
+    if((p_text == p_own_text) || (p_text[0] == '\0'))
+    {
+        snprintf(p_text, MAX_UINT32_STR_LEN, "%u", score);
+    }
 
-static gameDisplayObjDestroy(gameDisplayObj_t *p_obj)
-{
-    free(p_obj);
+    return p_text;
 }
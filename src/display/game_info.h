@@ -44,7 +44,8 @@
 
 /* ***********************   Function Prototypes   ************************ */
 
-displayEventHandlerFcn_t *gameDisplayInit(const gameDataNode_t *p_node);
+displayEventHandlerFcn_t *gameDisplayInit(const gameDataList_t *p_game_list);
+void gameDisplayDestroy(void);
 void gameDisplayGames(SDL_Renderer *renderer);
 
 
@@ -41,6 +41,18 @@
 // Module Includes
 #include "enum_label.h"
 
+/* ***************************   Definitions   **************************** */
+
+// Position in the dense table of values that have no label
+#define ENUM_LABEL_INDEX_NONE   0xFF
+
+// ASCII only, so the result does not depend on the locale
+#define EL_FOLD_CASE(c)         ((((c) >= 'A') && ((c) <= 'Z')) ? ((c) + ('a' - 'A')) : (c))
+
+/* ***********************   Function Prototypes   ************************ */
+
+static int elCompareFolded(const char *const label_a, const char *const label_b, const int len);
+
 /* *************************   Public  Functions   ************************ */
 
 //
@@ -122,6 +134,12 @@ bool elGetValueFromBuffer(const enumLabel_t *el, const char *const label,
             cmp_res = _strnicmp(el->label, label, label_size);
         }
 
+        // The buffer is only a prefix of labels that are longer
+        if ((cmp_res == 0) && (strlen(el->label) != (size_t)label_size))
+        {
+            cmp_res = 1;
+        }
+
         if (cmp_res == 0)
         {
             *value = el->value;
@@ -135,3 +153,168 @@ bool elGetValueFromBuffer(const enumLabel_t *el, const char *const label,
 
     return found;
 }
+
+//
+// Compiles a {value, label} table for the elIndex* functions. The table must outlive the index.
+// Returns false if the table is too large to be compiled, the index can still be used but is not any faster.
+//
+bool elIndexInit(enumLabelIndex_t *const p_index, const enumLabel_t *const el)
+{
+    assert((p_index != NULL) && (el != NULL));
+    memset(p_index, 0, sizeof(enumLabelIndex_t));
+    p_index->p_labels = el;
+
+    int min_value = 0;
+    int max_value = 0;
+    bool fits = true;
+    while (el[p_index->num_labels].label != NULL)
+    {
+        const enumLabel_t *const p_label = &el[p_index->num_labels];
+        fits = fits && (p_index->num_labels < ENUM_LABEL_INDEX_MAX_LABELS) &&
+               (strlen(p_label->label) <= ENUM_LABEL_INDEX_MAX_LEN);
+
+        min_value = ((p_index->num_labels == 0) || (p_label->value < min_value)) ? p_label->value : min_value;
+        max_value = ((p_index->num_labels == 0) || (p_label->value > max_value)) ? p_label->value : max_value;
+        p_index->num_labels++;
+    }
+
+    if (fits)
+    {
+        // Insertion sort by length, then case folded label. Labels that compare equal stay in table order, so
+        // the first one in the table is found first, like the el* functions do.
+        for (int idx = 0; idx < p_index->num_labels; idx++)
+        {
+            const int len = (int)strlen(el[idx].label);
+            int pos = idx;
+            bool in_place = false;
+            while ((pos > 0) && !in_place)
+            {
+                const char *const p_prev_label = el[p_index->sorted[pos - 1]].label;
+                const int prev_len = (int)strlen(p_prev_label);
+                in_place = ((prev_len < len) ||
+                            ((prev_len == len) && (elCompareFolded(p_prev_label, el[idx].label, len) <= 0)));
+
+                if (!in_place)
+                {
+                    p_index->sorted[pos] = p_index->sorted[pos - 1];
+                    pos--;
+                }
+            }
+            p_index->sorted[pos] = (uint8_t)idx;
+
+            // Count the labels of each length, turned into start positions below
+            p_index->len_start[len + 1]++;
+        }
+
+        for (int len = 1; len < (int)(sizeof(p_index->len_start) / sizeof(p_index->len_start[0])); len++)
+        {
+            p_index->len_start[len] += p_index->len_start[len - 1];
+        }
+
+        // Direct lookup of the labels of values that are close together
+        const int64_t spread = ((int64_t)max_value - min_value + 1);
+        if ((p_index->num_labels > 0) && (spread <= ENUM_LABEL_INDEX_MAX_DENSE))
+        {
+            p_index->min_value = min_value;
+            p_index->num_dense = (int)spread;
+            memset(p_index->dense, ENUM_LABEL_INDEX_NONE, sizeof(p_index->dense));
+
+            for (int idx = (p_index->num_labels - 1); idx >= 0; idx--)
+            {
+                // Going backwards leaves the first label of a value in the table
+                p_index->dense[el[idx].value - min_value] = (uint8_t)idx;
+            }
+        }
+
+        p_index->compiled = true;
+    }
+
+    return p_index->compiled;
+}
+
+//
+// Figures out what value is associated with a label, using a compiled table. The label does not have to be
+// NULL terminated.
+//
+bool elIndexGetValue(const enumLabelIndex_t *const p_index, const char *const label, const int label_size,
+                     int *const value, const bool case_sensitive)
+{
+    bool found = false;
+
+    if (!p_index->compiled)
+    {
+        found = elGetValueFromBuffer(p_index->p_labels, label, label_size, value, case_sensitive);
+    }
+    else if ((label_size >= 0) && (label_size <= ENUM_LABEL_INDEX_MAX_LEN))
+    {
+        // Lower bound of the label among the labels of the same length
+        int low = p_index->len_start[label_size];
+        int high = p_index->len_start[label_size + 1];
+        while (low < high)
+        {
+            const int mid = (low + high) / 2;
+            if (elCompareFolded(p_index->p_labels[p_index->sorted[mid]].label, label, label_size) < 0)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+
+        // Labels that only differ by case are next to each other, in table order
+        const int end = p_index->len_start[label_size + 1];
+        for (int pos = low; !found && (pos < end) &&
+                            (elCompareFolded(p_index->p_labels[p_index->sorted[pos]].label, label, label_size) == 0); pos++)
+        {
+            const enumLabel_t *const p_label = &p_index->p_labels[p_index->sorted[pos]];
+            if (!case_sensitive || (memcmp(p_label->label, label, label_size) == 0))
+            {
+                *value = p_label->value;
+                found = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+//
+// Figures out what label is associated with a value, using a compiled table
+//
+const char *elIndexGetLabel(const enumLabelIndex_t *const p_index, const int value)
+{
+    const char *label = NULL;
+
+    if (p_index->num_dense > 0)
+    {
+        const int64_t offset = ((int64_t)value - p_index->min_value);
+        if ((offset >= 0) && (offset < p_index->num_dense) && (p_index->dense[offset] != ENUM_LABEL_INDEX_NONE))
+        {
+            label = p_index->p_labels[p_index->dense[offset]].label;
+        }
+    }
+    else
+    {
+        label = elGetLabel(p_index->p_labels, value);
+    }
+
+    return label;
+}
+
+/* *************************   Private Functions   ************************ */
+
+// Compares the first `len` characters of two labels, ignoring case
+static int elCompareFolded(const char *const label_a, const char *const label_b, const int len)
+{
+    int cmp_res = 0;
+    for (int idx = 0; (cmp_res == 0) && (idx < len); idx++)
+    {
+        const int char_a = EL_FOLD_CASE((unsigned char)label_a[idx]);
+        const int char_b = EL_FOLD_CASE((unsigned char)label_b[idx]);
+        cmp_res = (char_a - char_b);
+    }
+
+    return cmp_res;
+}
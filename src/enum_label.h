@@ -6,6 +6,11 @@
 //
 //  Utility that helps conversion of enumerated values to strings and back.
 //
+//  The el* functions go through the {value, label} table on every call. A table that is looked up
+//  often can be compiled into an enumLabelIndex_t once, with elIndexInit(), and looked up with the
+//  elIndex* functions instead: labels are found with a binary search among the labels of the same
+//  length, and labels are found from values with a direct lookup when the values are close together.
+//
 // The MIT License (MIT)
 //
 // Copyright (c) 2020, Thomas Bresson
@@ -36,12 +41,21 @@
 /* ***************************    Includes     **************************** */
 
 #include <stdbool.h>
+#include <stdint.h>
 
 /* ***************************   Definitions   **************************** */
 
 // Put this at the end of the enumLabel_t array of data to indicate the end
 #define ENUM_LABEL_END          { 0, NULL}
 
+// Limits of the tables that can be compiled into an index. Tables past these can still be used
+// with an index, it then falls back to going through the table.
+#define ENUM_LABEL_INDEX_MAX_LABELS     64
+#define ENUM_LABEL_INDEX_MAX_LEN        40
+
+// Largest spread of values (highest - lowest + 1) for which values are looked up with a direct table
+#define ENUM_LABEL_INDEX_MAX_DENSE      64
+
 /* ****************************   Structures   **************************** */
 
 // !WARNING: An array of this data MUST END WITH and entry of `ENUM_LABEL_END`
@@ -51,6 +65,25 @@ typedef struct
     char *label;
 } enumLabel_t;
 
+// Compiled {value, label} table, see elIndexInit(). All of the members are private to the module.
+typedef struct
+{
+    const enumLabel_t *p_labels;
+    int num_labels;
+    bool compiled; // False if the table did not fit, lookups then go through the table
+
+    // Positions in the table, sorted by label length, then by case folded label (table order between equal labels).
+    // The labels that are `len` long are at sorted[len_start[len]] up to, but not including, sorted[len_start[len + 1]].
+    uint8_t sorted[ENUM_LABEL_INDEX_MAX_LABELS];
+    uint8_t len_start[ENUM_LABEL_INDEX_MAX_LEN + 2];
+
+    // Position in the table of the first label of each value, from `min_value` up to (min_value + num_dense - 1).
+    // Values without a label have an out of range position. num_dense is 0 if the values are too far apart.
+    int min_value;
+    int num_dense;
+    uint8_t dense[ENUM_LABEL_INDEX_MAX_DENSE];
+} enumLabelIndex_t;
+
 /* ***********************   Function Prototypes   ************************ */
 
 bool elGetValueFromString(const enumLabel_t *el, const char *const label, int *value, bool case_sensitive);
@@ -58,4 +91,9 @@ bool elGetValueFromBuffer(const enumLabel_t *el, const char *const label,
                           int label_size, int *value, bool case_sensitive);
 const char *elGetLabel(enumLabel_t const *el, const int value);
 
+bool elIndexInit(enumLabelIndex_t *const p_index, const enumLabel_t *const el);
+bool elIndexGetValue(const enumLabelIndex_t *const p_index, const char *const label, const int label_size,
+                     int *const value, const bool case_sensitive);
+const char *elIndexGetLabel(const enumLabelIndex_t *const p_index, const int value);
+
 #endif /* ENUM_LABEL_H */
@@ -45,7 +45,8 @@ typedef enum
 {
     APPERR_OK = 0,
     APPERR_JSON_DATA_UNABLE_TO_BE_RETRIVED,
-    APPERR_UNABLE_TO_ALLOCATE_MEMORY
+    APPERR_UNABLE_TO_ALLOCATE_MEMORY,
+    APPERR_JSON_MISSING_REQUIRED_KEY
 }appErrors_t;
 
 /* ****************************   Structures   **************************** */
@@ -0,0 +1,313 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  game_data_feed.c
+//
+//  Game Data Feed
+//
+//  Module description in game_data_feed.h
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/* ***************************    Includes     **************************** */
+
+// Std Includes
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+
+// Lib Includes
+#include <SDL.h>
+
+// Project Includes
+#include "game_data_parser.h"
+
+// Module Includes
+#include "game_data_feed.h"
+
+/* ***********************   Function Prototypes   ************************ */
+
+static int gameDataFeedThreadMain(void *p_data);
+static void gameDataFeedGather(gameDataFeed_t *const p_feed);
+static void gameDataFeedPublish(gameDataFeed_t *const p_feed, gameDataList_t *const p_list);
+static void gameDataFeedReclaim(gameDataFeed_t *const p_feed);
+static void gameDataFeedSnapshotFree(gameDataSnapshot_t *const p_snapshot);
+
+/* ****************************   BEGIN CODE   **************************** */
+
+/* *************************   Public  Functions   ************************ */
+
+// Sets up a feed of the game data at `p_json_url`, which must outlive the feed. The data is gathered again every
+// `refresh_ms` once started, or only once if it is 0.
+void gameDataFeedInit(gameDataFeed_t *const p_feed, const char *const p_json_url, const Uint32 refresh_ms)
+{
+    p_feed->p_current = NULL;
+    SDL_AtomicSet(&p_feed->epoch, (GAME_DATA_FEED_NOT_READING + 1));
+    for (int idx = 0; idx < GAME_DATA_FEED_MAX_READERS; idx++)
+    {
+        SDL_AtomicSet(&p_feed->reader_epochs[idx], GAME_DATA_FEED_NOT_READING);
+    }
+
+    gameDataParserInit(&p_feed->parser);
+    p_feed->p_json_url = p_json_url;
+    p_feed->refresh_ms = refresh_ms;
+    p_feed->p_retired = NULL;
+    p_feed->p_thread = NULL;
+    p_feed->p_lock = NULL;
+    p_feed->p_stop_requested = NULL;
+    p_feed->stopping = false;
+
+    p_feed->num_versions = 0;
+    p_feed->num_reclaimed = 0;
+}
+
+// Starts gathering on the writer thread. Returns false if the thread could not be started.
+bool gameDataFeedStart(gameDataFeed_t *const p_feed)
+{
+    assert(p_feed->p_thread == NULL);
+
+    p_feed->p_lock = SDL_CreateMutex();
+    p_feed->p_stop_requested = SDL_CreateCond();
+    p_feed->stopping = false;
+
+    if ((p_feed->p_lock != NULL) && (p_feed->p_stop_requested != NULL))
+    {
+        p_feed->p_thread = SDL_CreateThread(gameDataFeedThreadMain, "GameDataFeed", p_feed);
+    }
+
+    if (p_feed->p_thread == NULL)
+    {
+        printf("Game data feed could not be started! SDL_Error: %s\n", SDL_GetError());
+    }
+
+    return (p_feed->p_thread != NULL);
+}
+
+// Stops the writer thread. A gather that is under way is finished first, so this can take as long as a gather.
+// The last snapshot published stays readable.
+void gameDataFeedStop(gameDataFeed_t *const p_feed)
+{
+    if (p_feed->p_thread != NULL)
+    {
+        SDL_LockMutex(p_feed->p_lock);
+        p_feed->stopping = true;
+        SDL_CondSignal(p_feed->p_stop_requested);
+        SDL_UnlockMutex(p_feed->p_lock);
+
+        SDL_WaitThread(p_feed->p_thread, NULL);
+        p_feed->p_thread = NULL;
+    }
+
+    if (p_feed->p_stop_requested != NULL)
+    {
+        SDL_DestroyCond(p_feed->p_stop_requested);
+        p_feed->p_stop_requested = NULL;
+    }
+
+    if (p_feed->p_lock != NULL)
+    {
+        SDL_DestroyMutex(p_feed->p_lock);
+        p_feed->p_lock = NULL;
+    }
+}
+
+// Gathers the game data on the calling thread, and publishes it, as the writer thread does for every refresh.
+// Used when the writer thread is not running (i.e. it could not be started), never while it is.
+void gameDataFeedRefresh(gameDataFeed_t *const p_feed)
+{
+    assert(p_feed->p_thread == NULL);
+
+    gameDataFeedGather(p_feed);
+}
+
+// Stops the feed and frees every snapshot, along with the parser
+// NOTE: Every reader must have left its read-side section
+void gameDataFeedDestroy(gameDataFeed_t *const p_feed)
+{
+    gameDataFeedStop(p_feed);
+
+    for (int idx = 0; idx < GAME_DATA_FEED_MAX_READERS; idx++)
+    {
+        assert(SDL_AtomicGet(&p_feed->reader_epochs[idx]) == GAME_DATA_FEED_NOT_READING);
+    }
+
+    while (p_feed->p_retired != NULL)
+    {
+        gameDataSnapshot_t *const p_next = p_feed->p_retired->p_next_retired;
+        gameDataFeedSnapshotFree(p_feed->p_retired);
+        p_feed->p_retired = p_next;
+    }
+
+    gameDataSnapshot_t *const p_current = SDL_AtomicSetPtr(&p_feed->p_current, NULL);
+    if (p_current != NULL)
+    {
+        gameDataFeedSnapshotFree(p_current);
+    }
+
+    // The games' interned strings are in the parser, it goes last
+    gameDataParserDestroy(&p_feed->parser);
+}
+
+// Enters a read-side section, or moves a reader that is in one on to the latest snapshot. Never blocks.
+// The snapshot stays valid until the reader locks again or unlocks, any snapshot it had before may be freed.
+// Returns NULL if no snapshot has been published yet.
+// reader_idx: From 0 to GAME_DATA_FEED_MAX_READERS - 1, one per reading thread
+const gameDataSnapshot_t *gameDataFeedReadLock(gameDataFeed_t *const p_feed, const int reader_idx)
+{
+    assert((reader_idx >= 0) && (reader_idx < GAME_DATA_FEED_MAX_READERS));
+
+    // The epoch is recorded before the snapshot is read, so the snapshot can't have been replaced
+    // before the recorded epoch, and it is kept until the reader moves on
+    SDL_AtomicSet(&p_feed->reader_epochs[reader_idx], SDL_AtomicGet(&p_feed->epoch));
+    return SDL_AtomicGetPtr(&p_feed->p_current);
+}
+
+// Leaves the read-side section, the snapshot the reader had may be freed
+void gameDataFeedReadUnlock(gameDataFeed_t *const p_feed, const int reader_idx)
+{
+    assert((reader_idx >= 0) && (reader_idx < GAME_DATA_FEED_MAX_READERS));
+
+    SDL_AtomicSet(&p_feed->reader_epochs[reader_idx], GAME_DATA_FEED_NOT_READING);
+}
+
+/* *************************   Private Functions   ************************ */
+
+// Writer thread, gathers the game data until the feed is stopped
+static int gameDataFeedThreadMain(void *p_data)
+{
+    gameDataFeed_t *const p_feed = (gameDataFeed_t *)p_data;
+
+    bool stopping = false;
+    while (!stopping)
+    {
+        gameDataFeedGather(p_feed);
+
+        // Wait for the next refresh, unless stopped in the meantime
+        SDL_LockMutex(p_feed->p_lock);
+        if (!p_feed->stopping)
+        {
+            if (p_feed->refresh_ms > 0)
+            {
+                SDL_CondWaitTimeout(p_feed->p_stop_requested, p_feed->p_lock, p_feed->refresh_ms);
+            }
+            else
+            {
+                while (!p_feed->stopping)
+                {
+                    SDL_CondWait(p_feed->p_stop_requested, p_feed->p_lock);
+                }
+            }
+        }
+        stopping = p_feed->stopping;
+        SDL_UnlockMutex(p_feed->p_lock);
+    }
+
+    return 0;
+}
+
+// Gathers the game data once and publishes it, then frees the snapshots readers are done with
+static void gameDataFeedGather(gameDataFeed_t *const p_feed)
+{
+    gameDataList_t list;
+    gameDataParserGatherData(&p_feed->parser, p_feed->p_json_url, &list);
+
+    // A failed refresh keeps the games already published, but the first gather is published either way
+    if ((list.num_games > 0) || (p_feed->num_versions == 0))
+    {
+        gameDataFeedPublish(p_feed, &list);
+    }
+    else
+    {
+        gameDataParserGameListDestroy(&list);
+    }
+    gameDataFeedReclaim(p_feed);
+}
+
+// Makes a list of games the current snapshot. The snapshot it replaces is retired, to be freed once no reader
+// can still have it. The list is taken over, or destroyed if a snapshot could not be allocated.
+static void gameDataFeedPublish(gameDataFeed_t *const p_feed, gameDataList_t *const p_list)
+{
+    gameDataSnapshot_t *const p_snapshot = malloc(sizeof(gameDataSnapshot_t));
+    if (p_snapshot != NULL)
+    {
+        p_snapshot->list = *p_list;
+        p_snapshot->version = ++p_feed->num_versions;
+        p_snapshot->retired_epoch = GAME_DATA_FEED_NOT_READING;
+        p_snapshot->p_next_retired = NULL;
+
+        // Readers that record the new epoch are sure to read the new snapshot
+        gameDataSnapshot_t *const p_replaced = SDL_AtomicSetPtr(&p_feed->p_current, p_snapshot);
+        const int new_epoch = (SDL_AtomicAdd(&p_feed->epoch, 1) + 1);
+
+        if (p_replaced != NULL)
+        {
+            p_replaced->retired_epoch = new_epoch;
+            p_replaced->p_next_retired = p_feed->p_retired;
+            p_feed->p_retired = p_replaced;
+        }
+    }
+    else
+    {
+        printf("Failed to publish the game data\n");
+        gameDataParserGameListDestroy(p_list);
+    }
+}
+
+// Frees the retired snapshots no reader can still have: those retired at or before the oldest epoch a reader
+// entered at. The others are left for the next time.
+static void gameDataFeedReclaim(gameDataFeed_t *const p_feed)
+{
+    int oldest_epoch = SDL_AtomicGet(&p_feed->epoch);
+    for (int idx = 0; idx < GAME_DATA_FEED_MAX_READERS; idx++)
+    {
+        const int reader_epoch = SDL_AtomicGet(&p_feed->reader_epochs[idx]);
+        if (reader_epoch != GAME_DATA_FEED_NOT_READING)
+        {
+            oldest_epoch = min(oldest_epoch, reader_epoch);
+        }
+    }
+
+    gameDataSnapshot_t **pp_link = &p_feed->p_retired;
+    while (*pp_link != NULL)
+    {
+        gameDataSnapshot_t *const p_snapshot = *pp_link;
+        if (p_snapshot->retired_epoch <= oldest_epoch)
+        {
+            *pp_link = p_snapshot->p_next_retired;
+            gameDataFeedSnapshotFree(p_snapshot);
+            p_feed->num_reclaimed++;
+        }
+        else
+        {
+            pp_link = &p_snapshot->p_next_retired;
+        }
+    }
+}
+
+static void gameDataFeedSnapshotFree(gameDataSnapshot_t *const p_snapshot)
+{
+    gameDataParserGameListDestroy(&p_snapshot->list);
+    free(p_snapshot);
+}
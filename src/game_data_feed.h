@@ -0,0 +1,108 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  game_data_feed.h
+//
+//  Game Data Feed
+//
+//  Gathers the game data on a background thread, and refreshes it periodically, while other
+//  threads (i.e. the render loop) read it. Each gather becomes an immutable snapshot of the game
+//  data, published by swapping the feed's current snapshot pointer atomically. Readers never block:
+//  entering a read-side section is a couple of atomic operations, after which the snapshot they got
+//  stays valid until they enter again or leave.
+//
+//  Replaced snapshots are reclaimed RCU-style. The feed's epoch goes up with every snapshot
+//  published, and each reader records the epoch it entered at. A replaced snapshot is freed once no
+//  reader entered before it was replaced. The writer never waits on readers for this: snapshots still
+//  in use are left on a list, and checked again after the next refresh.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef GAME_DATA_FEED_H
+#define GAME_DATA_FEED_H
+
+/* ***************************    Includes     **************************** */
+
+#include <stdbool.h>
+
+#include <SDL.h>
+
+#include "game_data_parser.h"
+
+/* ***************************   Definitions   **************************** */
+
+// Threads that can read the feed at once, each with its own reader index
+#define GAME_DATA_FEED_MAX_READERS          2
+
+// Epoch of a reader that is not in a read-side section
+#define GAME_DATA_FEED_NOT_READING          0
+
+/* ****************************   Structures   **************************** */
+
+// Games of one gather. Never changed once published.
+typedef struct GameDataSnapshot
+{
+    gameDataList_t list;
+    int version;        // 1 for the first gather, one more for every refresh
+
+    // Private to the module
+    int retired_epoch;  // Epoch of the snapshot that replaced it
+    struct GameDataSnapshot *p_next_retired;
+} gameDataSnapshot_t;
+
+// All of the members are private to the module, except for the stats.
+// NOTE: The writer thread points back to the feed, it must not be moved once started
+typedef struct
+{
+    // Shared with the readers
+    void *p_current;                                        // gameDataSnapshot_t, NULL until the first gather
+    SDL_atomic_t epoch;                                     // Goes up with every snapshot published
+    SDL_atomic_t reader_epochs[GAME_DATA_FEED_MAX_READERS]; // Epoch each reader entered at
+
+    // Writer
+    gameDataParser_t parser;
+    const char *p_json_url;
+    Uint32 refresh_ms;
+    gameDataSnapshot_t *p_retired;  // Replaced snapshots, newest first
+    SDL_Thread *p_thread;
+    SDL_mutex *p_lock;
+    SDL_cond *p_stop_requested;
+    bool stopping;
+
+    // Stats
+    int num_versions;   // Snapshots published
+    int num_reclaimed;  // Replaced snapshots freed
+} gameDataFeed_t;
+
+/* ***********************   Function Prototypes   ************************ */
+
+void gameDataFeedInit(gameDataFeed_t *const p_feed, const char *const p_json_url, const Uint32 refresh_ms);
+bool gameDataFeedStart(gameDataFeed_t *const p_feed);
+void gameDataFeedStop(gameDataFeed_t *const p_feed);
+void gameDataFeedRefresh(gameDataFeed_t *const p_feed);
+void gameDataFeedDestroy(gameDataFeed_t *const p_feed);
+const gameDataSnapshot_t *gameDataFeedReadLock(gameDataFeed_t *const p_feed, const int reader_idx);
+void gameDataFeedReadUnlock(gameDataFeed_t *const p_feed, const int reader_idx);
+
+#endif /* GAME_DATA_FEED_H */
@@ -0,0 +1,254 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  game_data_index.c
+//
+//  Game Data Index
+//
+//  Module description in game_data_index.h
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/* ***************************    Includes     **************************** */
+
+// Std Includes
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+// Project Includes
+#include "shared_data_types.h"
+
+// Module Includes
+#include "game_data_index.h"
+
+/* ***********************   Function Prototypes   ************************ */
+
+static bool gameDataIndexAddEntry(gameDataIndexTable_t *const p_table, const char *const p_key, const int key_len,
+                                  const int game_idx);
+static bool gameDataIndexMerge(gameDataIndexTable_t *const p_table);
+static int gameDataIndexCompareKeys(const char *const p_key_a, const int len_a, const char *const p_key_b,
+                                    const int len_b);
+static int gameDataIndexCompareEntries(const void *p_a, const void *p_b);
+static int gameDataIndexLowerBound(const gameDataIndexTable_t *const p_table, const char *const p_key,
+                                   const int key_len, const bool past_key);
+
+/* ****************************   BEGIN CODE   **************************** */
+
+/* *************************   Public  Functions   ************************ */
+
+// Sets up empty indexes, nothing is allocated until a game is added
+void gameDataIndexInit(gameDataIndex_t *const p_index)
+{
+    memset(p_index, 0, sizeof(gameDataIndex_t));
+}
+
+// Frees the indexes, they are left empty
+void gameDataIndexDestroy(gameDataIndex_t *const p_index)
+{
+    for (int key = 0; key < GAME_DATA_INDEX_NUM_KEYS; key++)
+    {
+        free(p_index->tables[key].p_entries);
+    }
+    gameDataIndexInit(p_index);
+}
+
+// Adds a game to the indexes, by its position in the list. The game can't be found until the indexes are updated.
+// The keys point into the game, which must not move for as long as it is indexed.
+// Returns false if an index could not be grown, the game may then be in some of the indexes only.
+bool gameDataIndexAdd(gameDataIndex_t *const p_index, const gameData_t *const p_game, const int game_idx)
+{
+    bool success = gameDataIndexAddEntry(&p_index->tables[GAME_DATA_INDEX_TEAM], p_game->home_team_name_str.str,
+                                         p_game->home_team_name_str.len, game_idx);
+    success = success && gameDataIndexAddEntry(&p_index->tables[GAME_DATA_INDEX_TEAM], p_game->away_team_name_str.str,
+                                               p_game->away_team_name_str.len, game_idx);
+    success = success && gameDataIndexAddEntry(&p_index->tables[GAME_DATA_INDEX_STATE], p_game->detailed_state_str.str,
+                                               p_game->detailed_state_str.len, game_idx);
+    success = success && gameDataIndexAddEntry(&p_index->tables[GAME_DATA_INDEX_DATE], p_game->date_str,
+                                               (int)min(strlen(p_game->date_str), GAME_DATA_INDEX_DATE_LEN), game_idx);
+
+    return success;
+}
+
+// Sorts the games added since the last update into the indexes. Only the new games are sorted, they are then
+// merged with the games already indexed. Returns false if an index could not be merged, its new games are
+// then still waiting for the next update.
+bool gameDataIndexUpdate(gameDataIndex_t *const p_index)
+{
+    bool success = true;
+    for (int key = 0; key < GAME_DATA_INDEX_NUM_KEYS; key++)
+    {
+        gameDataIndexTable_t *const p_table = &p_index->tables[key];
+        if (p_table->num_entries > p_table->num_sorted)
+        {
+            qsort(&p_table->p_entries[p_table->num_sorted], (p_table->num_entries - p_table->num_sorted),
+                  sizeof(gameDataIndexEntry_t), gameDataIndexCompareEntries);
+            success = gameDataIndexMerge(p_table) && success;
+        }
+    }
+
+    return success;
+}
+
+// Finds the games whose key is `p_value` (i.e. GAME_DATA_INDEX_TEAM and "New York Yankees", or GAME_DATA_INDEX_DATE
+// and "2018-06-10"). Games added since the last update are not found. The range is empty if there are no games.
+gameDataIndexRange_t gameDataIndexFind(const gameDataIndex_t *const p_index, const gameDataIndexKey_t key,
+                                       const char *const p_value)
+{
+    assert(key < GAME_DATA_INDEX_NUM_KEYS);
+
+    const gameDataIndexTable_t *const p_table = &p_index->tables[key];
+    const int value_len = (int)strlen(p_value);
+    const int first_idx = gameDataIndexLowerBound(p_table, p_value, value_len, false);
+    const int end_idx = gameDataIndexLowerBound(p_table, p_value, value_len, true);
+
+    gameDataIndexRange_t range = {.p_entries = NULL, .num_games = (end_idx - first_idx)};
+    if (range.num_games > 0)
+    {
+        range.p_entries = &p_table->p_entries[first_idx];
+    }
+
+    return range;
+}
+
+/* *************************   Private Functions   ************************ */
+
+// Appends an entry after the others, doubling the storage when it is full
+static bool gameDataIndexAddEntry(gameDataIndexTable_t *const p_table, const char *const p_key, const int key_len,
+                                  const int game_idx)
+{
+    if (p_table->num_entries == p_table->capacity)
+    {
+        const int new_capacity = (p_table->capacity > 0) ? (p_table->capacity * 2) : GAME_DATA_INDEX_DEFAULT_ENTRIES;
+        gameDataIndexEntry_t *p_new_entries = realloc(p_table->p_entries, (new_capacity * sizeof(gameDataIndexEntry_t)));
+        if (p_new_entries != NULL)
+        {
+            p_table->p_entries = p_new_entries;
+            p_table->capacity = new_capacity;
+        }
+    }
+
+    const bool has_room = (p_table->num_entries < p_table->capacity);
+    if (has_room)
+    {
+        gameDataIndexEntry_t *const p_entry = &p_table->p_entries[p_table->num_entries];
+        p_entry->p_key = p_key;
+        p_entry->key_len = key_len;
+        p_entry->game_idx = game_idx;
+        p_table->num_entries++;
+    }
+
+    return has_room;
+}
+
+// Merges the sorted new entries with the entries sorted before them
+static bool gameDataIndexMerge(gameDataIndexTable_t *const p_table)
+{
+    gameDataIndexEntry_t *p_merged = NULL;
+    if (p_table->num_sorted > 0)
+    {
+        p_merged = malloc(p_table->capacity * sizeof(gameDataIndexEntry_t));
+    }
+
+    if (p_merged != NULL)
+    {
+        int old_idx = 0;
+        int new_idx = p_table->num_sorted;
+        int merged_idx = 0;
+        while ((old_idx < p_table->num_sorted) || (new_idx < p_table->num_entries))
+        {
+            const bool take_old = (new_idx == p_table->num_entries) ||
+                                  ((old_idx < p_table->num_sorted) &&
+                                   (gameDataIndexCompareEntries(&p_table->p_entries[old_idx], &p_table->p_entries[new_idx]) <= 0));
+            p_merged[merged_idx++] = take_old ? p_table->p_entries[old_idx++] : p_table->p_entries[new_idx++];
+        }
+
+        free(p_table->p_entries);
+        p_table->p_entries = p_merged;
+    }
+
+    // Nothing to merge with when the index was empty, the new entries are sorted where they are
+    const bool success = ((p_table->num_sorted == 0) || (p_merged != NULL));
+    if (success)
+    {
+        p_table->num_sorted = p_table->num_entries;
+    }
+
+    return success;
+}
+
+// Orders keys by length, then by their characters. Keys of the same length (i.e. days) are in character order.
+static int gameDataIndexCompareKeys(const char *const p_key_a, const int len_a, const char *const p_key_b,
+                                    const int len_b)
+{
+    int order = (len_a - len_b);
+    if ((order == 0) && (p_key_a != p_key_b))
+    {
+        // Interned keys are the same string, so most equal keys are found without comparing characters
+        order = memcmp(p_key_a, p_key_b, len_a);
+    }
+
+    return order;
+}
+
+// qsort() comparator of index entries, by key and then by position
+static int gameDataIndexCompareEntries(const void *p_a, const void *p_b)
+{
+    const gameDataIndexEntry_t *const p_entry_a = (const gameDataIndexEntry_t *)p_a;
+    const gameDataIndexEntry_t *const p_entry_b = (const gameDataIndexEntry_t *)p_b;
+
+    int order = gameDataIndexCompareKeys(p_entry_a->p_key, p_entry_a->key_len, p_entry_b->p_key, p_entry_b->key_len);
+    if (order == 0)
+    {
+        order = (p_entry_a->game_idx > p_entry_b->game_idx) - (p_entry_a->game_idx < p_entry_b->game_idx);
+    }
+
+    return order;
+}
+
+// Binary search of the sorted entries. Gets the first entry whose key is not before `p_key`, or with `past_key`,
+// the first entry whose key is after it.
+static int gameDataIndexLowerBound(const gameDataIndexTable_t *const p_table, const char *const p_key,
+                                   const int key_len, const bool past_key)
+{
+    int low = 0;
+    int high = p_table->num_sorted;
+    while (low < high)
+    {
+        const int mid = low + ((high - low) / 2);
+        const gameDataIndexEntry_t *const p_entry = &p_table->p_entries[mid];
+        const int order = gameDataIndexCompareKeys(p_entry->p_key, p_entry->key_len, p_key, key_len);
+        if ((order < 0) || (past_key && (order == 0)))
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
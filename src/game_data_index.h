@@ -0,0 +1,102 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  game_data_index.h
+//
+//  Game Data Index
+//
+//  Secondary indexes over a list of games, so the games of a team, in a given state or on a given
+//  day can be found without walking the whole list. Each index is an array of (key, game position)
+//  entries sorted by key, the games with a given key are then a range of it, found by binary search.
+//  Games are added one at a time, and sorted into the indexes in batches by gameDataIndexUpdate().
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef GAME_DATA_INDEX_H
+#define GAME_DATA_INDEX_H
+
+/* ***************************    Includes     **************************** */
+
+#include <stdbool.h>
+
+#include "shared_data_types.h"
+
+/* ***************************   Definitions   **************************** */
+
+// Length of the day of a gameDate (YYYY-MM-DD). Days are in UTC, as in the JSON data.
+#define GAME_DATA_INDEX_DATE_LEN        (sizeof("2018-12-31") - 1)
+
+// Entries each index makes room for at first, grows as needed
+#define GAME_DATA_INDEX_DEFAULT_ENTRIES 64
+
+/* ****************************   Structures   **************************** */
+
+typedef enum
+{
+    GAME_DATA_INDEX_TEAM = 0,   // Home and away team names, so each game is in the index twice
+    GAME_DATA_INDEX_STATE,      // status.detailedState
+    GAME_DATA_INDEX_DATE,       // Day of gameDate, days sort in date order
+    GAME_DATA_INDEX_NUM_KEYS
+} gameDataIndexKey_t;
+
+// A game, by its position in the list of games, and its key. The key points into the game.
+typedef struct
+{
+    const char *p_key;
+    int key_len;
+    int game_idx;
+} gameDataIndexEntry_t;
+
+// All of the members are private to the module. Entries are sorted by key (shorter keys first), then by
+// position. Entries past `num_sorted` were added since the last update.
+typedef struct
+{
+    gameDataIndexEntry_t *p_entries;
+    int num_sorted;
+    int num_entries;
+    int capacity;
+} gameDataIndexTable_t;
+
+typedef struct
+{
+    gameDataIndexTable_t tables[GAME_DATA_INDEX_NUM_KEYS];
+} gameDataIndex_t;
+
+// Games found by a query, in list order. Valid until the index is updated or destroyed.
+typedef struct
+{
+    const gameDataIndexEntry_t *p_entries;
+    int num_games;
+} gameDataIndexRange_t;
+
+/* ***********************   Function Prototypes   ************************ */
+
+void gameDataIndexInit(gameDataIndex_t *const p_index);
+void gameDataIndexDestroy(gameDataIndex_t *const p_index);
+bool gameDataIndexAdd(gameDataIndex_t *const p_index, const gameData_t *const p_game, const int game_idx);
+bool gameDataIndexUpdate(gameDataIndex_t *const p_index);
+gameDataIndexRange_t gameDataIndexFind(const gameDataIndex_t *const p_index, const gameDataIndexKey_t key,
+                                       const char *const p_value);
+
+#endif /* GAME_DATA_INDEX_H */
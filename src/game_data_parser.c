@@ -41,6 +41,7 @@
 #include <assert.h>
 
 // Libs
+#include <SDL.h>
 #include "jsmn/jsmn.h"
 
 // App
@@ -48,404 +49,1384 @@
 #include "errors.h"
 #include "utility.h"
 #include "json_deserialization.h"
+#include "json_stream.h"
+#include "json_number.h"
+#include "json_serialization.h"
+#include "mem_arena.h"
+#include "string_intern.h"
+#include "generated/game_data_obj.h"
 
 // Module
 #include "game_data_parser.h"
 
 /* ***************************   Definitions   **************************** */
 
-#define DEFAULT_NUM_TOKENS_TO_ALLOC 2500
+// When enabled, the JSON data is tokenized on demand: only the values on the key paths in
+// `g_list_of_game_obj_values` are tokenized, every other subtree (i.e. most of "content.editorial")
+// is skipped over without producing tokens.
+#define GAME_DATA_FILTERED_TOKENIZATION_ENABLED     (1)
+
+// Key path of the array of games in the JSON data
+#define GAME_DATA_GAMES_ARRAY_PATH                  "dates.games"
+
+// Path expressions of the arrays of games (one per date), and of every game in them
+#define GAME_DATA_GAMES_ARRAYS_EXPR                 "dates[*].games"
+#define GAME_DATA_GAMES_EXPR                        "dates[*].games[*]"
+
+// When enabled, the JSON data is tokenized as it is downloaded, one game at a time, instead of
+// downloading the whole document into a buffer first. Memory use no longer grows with the size of
+// the document, which matters for long date ranges (i.e. a whole season).
+#define GAME_DATA_STREAMED_PARSING_ENABLED          (0)
+
+// When enabled, the whole JSON document is downloaded, the games in it are located with a quick scan,
+// and then tokenized and deserialized by several threads at once, each working on its own range of games.
+// Takes priority over streamed parsing.
+#define GAME_DATA_PARALLEL_PARSING_ENABLED          (0)
+
+// When enabled, parallel parsing is timed with 1 to GAME_DATA_NUM_PARSE_THREADS threads before
+// the games are parsed, and the results are printed. Images are not downloaded while timing.
+#define GAME_DATA_PARALLEL_BENCHMARK_ENABLED        (0)
+#define GAME_DATA_BENCHMARK_ITERATIONS              20
+
+// When enabled, game objects are deserialized by the function generated from src/schemas/game_data_obj.schema
+// (tools/json_codegen.py), with the key matching and conversions written out for each key. When disabled, the
+// generic deserializer goes through `g_list_of_game_obj_values` instead. Both produce the same result.
+#define GAME_DATA_GENERATED_DESERIALIZER_ENABLED    (1)
+
+// When enabled, the games of the document are deserialized GAME_DATA_BENCHMARK_ITERATIONS times with the generated
+// deserializer and then with the generic one, before they are gathered, and the timings are printed.
+#define GAME_DATA_DESERIALIZER_BENCHMARK_ENABLED    (0)
+
+// When enabled, the games of documents with at least GAME_DATA_PARALLEL_MIN_GAMES games are deserialized by the
+// parser's worker pool once the document is tokenized, GAME_DATA_PARALLEL_CHUNK_SIZE games per job. Every game has
+// its slot in the array of games set aside up front, so the games end up identical, and in the same order, as when
+// deserialized one array at a time. Images are still downloaded one game after the other afterwards.
+#define GAME_DATA_PARALLEL_DESERIALIZATION_ENABLED  (1)
+#define GAME_DATA_PARALLEL_MIN_GAMES                256
+#define GAME_DATA_PARALLEL_CHUNK_SIZE               64
+
+// When enabled, a synthetic document of GAME_DATA_SYNTHETIC_NUM_GAMES generated games is deserialized
+// GAME_DATA_BENCHMARK_ITERATIONS times serially and then in parallel, before the games are gathered. The results
+// are compared, and the timings are printed.
+#define GAME_DATA_SYNTHETIC_BENCHMARK_ENABLED       (0)
+#define GAME_DATA_SYNTHETIC_NUM_GAMES               10000
+
+// When enabled, the games of the document are serialized back into JSON GAME_DATA_BENCHMARK_ITERATIONS times once
+// they are deserialized, and the throughput is printed. The text is then deserialized again, and the games are
+// checked against the ones it was written from.
+#define GAME_DATA_SERIALIZER_BENCHMARK_ENABLED      (0)
+
+// When enabled, the games gathered from a whole downloaded document point into that document instead of copying
+// their strings out of it. The document is kept for as long as the dataset of the games is, see gameDataSet_t.
+// Strings are NULL terminated in place, over their closing quote. Streamed parsing still copies.
+#define GAME_DATA_ZERO_COPY_ENABLED                 (1)
+
+// When enabled, team names and game states are interned in the parser's string table instead of being stored with
+// each game: every game with the same text points to the same string, and has the same intern id for it.
+// The table is kept from one gather to the next, so it only ever holds the distinct values seen.
+#define GAME_DATA_STRING_INTERNING_ENABLED          (1)
+
+// When enabled, the games of a list are indexed by team, state and day once they are gathered, see game_data_index.h
+#define GAME_DATA_INDEXING_ENABLED                  (1)
+
+// Memory expected for each game of a list, mostly for its thumbnail (a 480x270 JPEG). Used to size the first block
+// of the dataset's arena, so most lists fit in a block or two.
+#define GAME_DATA_LIST_BYTES_PER_GAME               (32 * 1024)
+
+// Number of game locations allocated at first, grows as needed
+#define GAME_DATA_DEFAULT_NUM_SPANS                 64
+
+// Number of games streamed parsing makes room for at first, grows as needed
+#define GAME_DATA_DEFAULT_NUM_STREAMED_GAMES        64
 
 /* ****************************   Structures   **************************** */
 
-// Stuct in which the game json data will be parsed into
+// Context handed to the stream callback. The number of games isn't known until the stream ends, so they are
+// gathered in a growable array first, and moved into the dataset at the end.
 typedef struct
 {
-    jsonStr_t game_date;      // gameDate
-    jsonStr_t home_team_name; // teams.home.team.name
-    jsonStr_t away_team_name; // teams.away.team.name
-    jsonStr_t detailed_state; // status.detailedState
-    uint32_t home_score;      // teams.home.score
-    uint32_t away_score;      // teams.away.score
-    jsonStr_t img_url;        // content.editorial.recap.home.photo.cuts.960x540.src
-} gameDataObj_t;
+    gameData_t *p_games;
+    int num_games;
+    int capacity;
+    struct GameDataSet *p_dataset;
+    stringInternTable_t *p_strings;
+} gameDataStreamCtx_t;
+
+// Location of a game object within the JSON document
+typedef struct
+{
+    size_t start;
+    size_t len;
+} gameDataSpan_t;
+
+// Growable list of the game objects located in the JSON document
+typedef struct
+{
+    gameDataSpan_t *p_spans;
+    int num_spans;
+    int capacity;
+} gameDataSpanList_t;
+
+// Range of games parsed by one job of the worker pool, and the games it built
+typedef struct
+{
+    const char *p_json_buff;
+    const gameDataSpan_t *p_spans; // First game of the range
+    int num_games;
+    jsonTokenArena_t *p_token_arena;
+
+    // Games are built into the range's part of the array, one slot per span, NULL when the games are only
+    // deserialized (for timing). Their strings and images are allocated out of an arena of the range's own, which
+    // is added to the dataset once the range is done.
+    gameData_t *p_games;
+    int num_built;
+    struct GameDataSet *p_dataset;
+    memArena_t list_arena;
+    stringInternTable_t *p_strings;
+} gameDataParseRange_t;
+
+// Token index of every game object in a document, in document order
+typedef struct
+{
+    int *p_toks;
+    int max_games;
+    int num_games;
+} gameDataGameToks_t;
+
+// Games shared out to the worker pool, see gameDataDeserializeGamesParallel()
+typedef struct
+{
+    const jsmnTokenizationData_t *p_tok_data;
+    const char *p_json_buff;
+    const gameDataGameToks_t *p_game_toks;
+    gameDataObj_t *p_games;
+    bool *p_found_keys;                  // GAME_DATA_OBJ_NUM_KEYS per game
+    jsonStringCache_t *p_worker_strings; // One per worker
+} gameDataParallelGames_t;
+
+// Destination of the games deserialized out of each array of games, see gameDataDeserializeGames()
+typedef struct
+{
+    const char *p_json_buff;
+    gameDataObj_t *p_games; // NULL when the games are only being counted
+    bool *p_found_keys;     // GAME_DATA_OBJ_NUM_KEYS per game
+    int max_games;
+    int num_games;
+} gameDataGamesDest_t;
+
+// Memory of the list of games built by a gather. The nodes, the games, their strings and images are all allocated
+// out of the arena, the dataset itself included, so the whole list is freed at once.
+// Reference counted, the list holds the first reference.
+typedef struct GameDataSet
+{
+    SDL_atomic_t ref_count;
+    memArena_t arena;
+    httpDataBuffer_t json_data; // Download buffer the strings point into, empty when they were copied
+} gameDataSet_t;
 
 /* ***********************   Function Prototypes   ************************ */
 
-static bool gameDataTokenizeJson(jsmnTokenizationData_t *const p_token_data, const char *const p_json_buff,
-                                 const size_t json_content_length);
-static int gameDataFindArray(const jsmnTokenizationData_t *const p_tok_data, const httpDataBuffer_t *const p_buff,
-                             const char *const key_of_array_str);
-static gameDataNode_t *gameDataDeserializeGames(const int game_array_idx, const jsmnTokenizationData_t *const p_token_data,
-                                     const char *const p_json_buff, const size_t json_content_length);
-static gameDataNode_t *gameDataDeserializeGame(const gameDataObj_t *p_game_data_obj, gameDataNode_t *p_prev_node);
-static void gameDataFreeTokenData(jsmnTokenizationData_t *const p_token_data);
+static void gameDataGatherBuffered(gameDataParser_t *const p_parser, const char *const p_json_url,
+                                   gameDataList_t *const p_list);
+static void gameDataGatherStreamed(gameDataParser_t *const p_parser, const char *const p_json_url,
+                                   gameDataList_t *const p_list);
+static bool gameDataStreamChunkCbk(void *p_ctx, const char *const p_chunk, const size_t chunk_len);
+static bool gameDataStreamGameCbk(void *p_ctx, const char *const p_element, const int element_len,
+                                  const jsmnTokenizationData_t *const p_tok_data);
+static void gameDataGatherParallel(gameDataParser_t *const p_parser, const char *const p_json_url,
+                                   gameDataList_t *const p_list);
+static bool gameDataSpanCbk(void *p_ctx, const size_t element_start, const size_t element_len);
+static int gameDataParseGamesParallel(gameDataParser_t *const p_parser, const char *const p_json_buff,
+                                      const gameDataSpanList_t *const p_span_list, const int num_threads,
+                                      gameDataSet_t *const p_dataset, gameData_t *const p_games);
+static void gameDataParseRangeJob(void *p_ctx, const int job_idx, const int worker_idx);
+static void gameDataBenchmarkParallel(gameDataParser_t *const p_parser, const char *const p_json_buff,
+                                      const gameDataSpanList_t *const p_span_list);
+static void gameDataBenchmarkDeserializers(const jsmnTokenizationData_t *const p_tok_data, const char *const p_json_buff,
+                                           gameDataObj_t *const p_games, bool *const p_found_keys, const int num_games);
+static void gameDataInitPaths(void);
+static int gameDataDeserializeGames(const jsmnTokenizationData_t *const p_tok_data, const char *const p_json_buff,
+                                    gameDataObj_t *const p_games, bool *const p_found_keys, const int max_games);
+static bool gameDataGamesArrayCbk(void *p_ctx, const jsmnTokenizationData_t *const p_tok_data, const int tok_idx);
+static void gameDataStartWorkers(gameDataParser_t *const p_parser);
+static int gameDataDeserializeGamesParallel(gameDataParser_t *const p_parser, const jsmnTokenizationData_t *const p_tok_data,
+                                            const char *const p_json_buff, gameDataObj_t *const p_games,
+                                            bool *const p_found_keys, const int max_games);
+static bool gameDataGameTokCbk(void *p_ctx, const jsmnTokenizationData_t *const p_tok_data, const int tok_idx);
+static void gameDataDeserializeChunkJob(void *p_ctx, const int job_idx, const int worker_idx);
+static void gameDataBenchmarkSynthetic(gameDataParser_t *const p_parser);
+static bool gameDataGamesEqual(const gameDataObj_t *const p_game_a, const gameDataObj_t *const p_game_b);
+static void gameDataBenchmarkSerializer(const gameDataObj_t *const p_games, const bool *const p_found_keys,
+                                        const int num_games);
+static appErrors_t gameDataDeserializeGameObj(const jsmnTokenizationData_t *const p_game_tok_data, const char *const p_obj_buff,
+                                              gameDataObj_t *const p_game_obj);
+static appErrors_t gameDataCheckGameKeys(const bool *const p_found_keys);
+static bool gameDataDeserializeGame(const gameDataObj_t *p_game_data_obj, gameData_t *const p_data,
+                                    gameDataSet_t *const p_dataset, memArena_t *const p_arena,
+                                    stringInternTable_t *const p_strings);
+static httpDataBuffer_t *gameDataDownloadImage(memArena_t *const p_arena, const char *const p_img_url);
+static gameDataSet_t *gameDataSetCreate(const size_t expected_size);
+static void gameDataSetKeepJson(gameDataSet_t *const p_dataset, httpDataBuffer_t *const p_json_data);
+static void gameDataSetFinish(gameDataParser_t *const p_parser, gameDataSet_t *const p_dataset,
+                              gameDataList_t *const p_list);
+static void gameDataSetRelease(gameDataSet_t *const p_dataset);
+static bool gameDataInJsonData(const httpDataBuffer_t *const p_json_data, const jsonStr_t *const p_src);
+static gameDataStr_t gameDataSetString(gameDataSet_t *const p_dataset, memArena_t *const p_arena,
+                                       const jsonStr_t *const p_src);
+static gameDataStr_t gameDataInternString(stringInternTable_t *const p_strings, gameDataSet_t *const p_dataset,
+                                          memArena_t *const p_arena, const jsonStr_t *const p_src);
 
 /* ***********************   File Scope Variables   *********************** */
 
-// Table of JSON related data to be parsed out of the JSON data pulled from the endpoint
-// NOTE: If the JSON format of objects in the "Games" array change, this would have to be changed as well.
-const jsonKeyValue_t g_list_of_game_obj_values[] =
-    {
-        {.key_str = "gameDate",
-         .c_type = E_JSON_C_STR_PTR,
-         .value_tok_type = JSMN_STRING,
-         .struct_member_offset = offsetof(gameDataObj_t, game_date),
-         .struct_member_size = MEMBER_SIZE(gameDataObj_t, game_date)},
-        {.key_str = "teams.home.team.name",
-         .c_type = E_JSON_C_STR_PTR,
-         .value_tok_type = JSMN_STRING,
-         .struct_member_offset = offsetof(gameDataObj_t, home_team_name),
-         .struct_member_size = MEMBER_SIZE(gameDataObj_t, home_team_name)},
-        {.key_str = "teams.away.team.name",
-         .c_type = E_JSON_C_STR_PTR,
-         .value_tok_type = JSMN_STRING,
-         .struct_member_offset = offsetof(gameDataObj_t, away_team_name),
-         .struct_member_size = MEMBER_SIZE(gameDataObj_t, away_team_name)},
-        {.key_str = "teams.home.score",
-         .c_type = E_JSON_C_UINT32,
-         .value_tok_type = JSMN_PRIMITIVE,
-         .struct_member_offset = offsetof(gameDataObj_t, home_score),
-         .struct_member_size = MEMBER_SIZE(gameDataObj_t, home_score)},
-        {.key_str = "teams.away.score",
-         .c_type = E_JSON_C_UINT32,
-         .value_tok_type = JSMN_PRIMITIVE,
-         .struct_member_offset = offsetof(gameDataObj_t, away_score),
-         .struct_member_size = MEMBER_SIZE(gameDataObj_t, away_score)},
-        {.key_str = "status.detailedState",
-         .c_type = E_JSON_C_STR_PTR,
-         .value_tok_type = JSMN_STRING,
-         .struct_member_offset = offsetof(gameDataObj_t, detailed_state),
-         .struct_member_size = MEMBER_SIZE(gameDataObj_t, detailed_state)},
-        {.key_str = "content.editorial.recap.home.photo.cuts.480x270.src",
-         .c_type = E_JSON_C_STR_PTR,
-         .value_tok_type = JSMN_STRING,
-         .struct_member_offset = offsetof(gameDataObj_t, img_url),
-         .struct_member_size = MEMBER_SIZE(gameDataObj_t, img_url)},
+// Key list of a game object, for the schema below. The table of keys is generated along with `gameDataObj_t`.
+// NOTE: If the JSON format of objects in the "Games" array change, src/schemas/game_data_obj.schema has to be changed.
+static const jsonKeyValueList_t g_game_obj_key_list =
+    {
+        .p_keys = g_list_of_game_obj_values,
+        .size = ARRAY_SIZE(g_list_of_game_obj_values),
 };
 
+// Schema of a game object, for deserializing each array of games in one go (jsonDeserializeArray())
+// NOTE: `p_deserialized_elements` is set for every array of games, so gathers can't overlap.
+static jsonContainer_t g_game_obj_container =
+    {
+        .type = E_JSON_OBJECT,
+        .p_key_list = &g_game_obj_key_list,
+#if (GAME_DATA_GENERATED_DESERIALIZER_ENABLED == 1)
+        .p_deserializer = gameDataObjDeserialize,
+#endif
+};
+
+// Schema compiled from the container above, and the arrays of games it is used on:
+// {"dates": [{"games": [{<game object>}, ...]}, ...]}
+static jsonSchema_t g_game_obj_schema;
+static jsonPathExpr_t g_games_arrays_expr;
+static jsonPathExpr_t g_games_expr;
+static bool g_game_obj_schema_initialized = false;
+
+// Container above compiled for writing games back out
+static jsonSerializer_t g_game_obj_serializer;
+
+// Path filters built from the table above. One for the whole JSON document, one for a single game object.
+// NULL when filtered tokenization is disabled.
+static const jsonPathFilter_t *g_p_document_filter = NULL;
+static const jsonPathFilter_t *g_p_game_filter = NULL;
+
+// Table above compiled into a trie of its key paths, so each game is deserialized in a single pass over its tokens
+static jsonPathTrie_t g_game_obj_trie;
+static bool g_game_obj_trie_initialized = false;
+
 /* ****************************   BEGIN CODE   **************************** */
 
 /* *************************   Public  Functions   ************************ */
 
-// Parses the game data at the URL provided and returns a linked list of game data
-gameDataNode_t *gameDataParserGatherData(const char *const p_json_url)
+// Sets up a parser. Nothing is allocated until the first gather.
+void gameDataParserInit(gameDataParser_t *const p_parser)
+{
+    jsonTokenArenaInit(&p_parser->document_tokens);
+    for (int idx = 0; idx < GAME_DATA_NUM_PARSE_THREADS; idx++)
+    {
+        jsonTokenArenaInit(&p_parser->game_tokens[idx]);
+        jsonStringCacheInit(&p_parser->worker_strings[idx]);
+    }
+    p_parser->workers_started = false;
+    p_parser->num_list_blocks = 0;
+    stringInternInit(&p_parser->strings);
+
+#if (JSON_NUMBER_BENCHMARK_ENABLED == 1)
+    jsonNumberBenchmark();
+#endif
+}
+
+// Frees the memory held by the parser
+// NOTE: Lists of games gathered with it must be destroyed first, their interned strings are freed with the parser
+void gameDataParserDestroy(gameDataParser_t *const p_parser)
+{
+    jsonTokenArenaDestroy(&p_parser->document_tokens);
+    for (int idx = 0; idx < GAME_DATA_NUM_PARSE_THREADS; idx++)
+    {
+        jsonTokenArenaDestroy(&p_parser->game_tokens[idx]);
+        jsonStringCacheDestroy(&p_parser->worker_strings[idx]);
+    }
+
+    if (p_parser->workers_started)
+    {
+        workerPoolDestroy(&p_parser->workers);
+        p_parser->workers_started = false;
+    }
+
+    stringInternDestroy(&p_parser->strings);
+}
+
+// Gets the token usage of the parser, can be used to tune the initial token storage size
+void gameDataParserGetStats(const gameDataParser_t *const p_parser, gameDataParserStats_t *const p_stats)
+{
+    p_stats->peak_document_tokens = p_parser->document_tokens.peak_tokens;
+    p_stats->num_token_reallocations = p_parser->document_tokens.num_reallocations;
+    p_stats->num_tokenizations = p_parser->document_tokens.num_tokenizations;
+    p_stats->peak_game_tokens = 0;
+    p_stats->num_list_allocations = p_parser->num_list_blocks;
+    p_stats->num_interned_strings = p_parser->strings.num_entries;
+    p_stats->num_intern_lookups = p_parser->strings.num_lookups;
+
+    for (int idx = 0; idx < GAME_DATA_NUM_PARSE_THREADS; idx++)
+    {
+        p_stats->peak_game_tokens = MAX(p_stats->peak_game_tokens, p_parser->game_tokens[idx].peak_tokens);
+        p_stats->num_token_reallocations += p_parser->game_tokens[idx].num_reallocations;
+        p_stats->num_tokenizations += p_parser->game_tokens[idx].num_tokenizations;
+    }
+}
+
+// Parses the game data at the URL provided into a list of games. Returns false if there are no games,
+// the list is then empty (and does not need to be destroyed).
+// The parser's token storage is reused, so gathering again does not need to allocate tokens.
+bool gameDataParserGatherData(gameDataParser_t *const p_parser, const char *const p_json_url, gameDataList_t *const p_list)
+{
+    gameDataInitPaths();
+
+    p_list->p_games = NULL;
+    p_list->num_games = 0;
+    p_list->p_dataset = NULL;
+    gameDataIndexInit(&p_list->index);
+
+#if (GAME_DATA_PARALLEL_PARSING_ENABLED == 1)
+    gameDataGatherParallel(p_parser, p_json_url, p_list);
+#elif (GAME_DATA_STREAMED_PARSING_ENABLED == 1)
+    gameDataGatherStreamed(p_parser, p_json_url, p_list);
+#else
+    gameDataGatherBuffered(p_parser, p_json_url, p_list);
+#endif
+
+    return (p_list->num_games > 0);
+}
+
+// Frees the list of games, the list is left empty
+void gameDataParserGameListDestroy(gameDataList_t *const p_list)
+{
+    // The games, and everything in them, go with the dataset
+    if (p_list->p_dataset != NULL)
+    {
+        gameDataSetRelease(p_list->p_dataset);
+    }
+    gameDataIndexDestroy(&p_list->index);
+
+    p_list->p_games = NULL;
+    p_list->num_games = 0;
+    p_list->p_dataset = NULL;
+}
+
+/* *************************   Private Functions   ************************ */
+
+// Downloads the whole JSON document into a buffer, tokenizes it and builds the list of games out of it
+static void gameDataGatherBuffered(gameDataParser_t *const p_parser, const char *const p_json_url,
+                                   gameDataList_t *const p_list)
 {
     // Take a URL and get the JSON data
     httpDataBuffer_t json_data_buff;
     curlLibBufferInit(&json_data_buff);
     appErrors_t error_status = curlLibGetData(&json_data_buff, p_json_url);
 
-    gameDataNode_t *p_first_node = NULL;
     if (error_status == APPERR_OK)
     {
         // Tokenize the JSON data
         jsmnTokenizationData_t token_data;
-        bool result = gameDataTokenizeJson(&token_data, json_data_buff.p_buffer, json_data_buff.content_length);
+        bool result = jsonTokenArenaTokenize(&p_parser->document_tokens, json_data_buff.p_buffer,
+                                             json_data_buff.content_length, g_p_document_filter, &token_data);
 
         if (result)
         {
-            // Seek to the "dates.games" array by searching the tokens
-            // NOTE: The reason this needs to be done is because the JSON deserialization only
-            // NOTE: operates deserializes json with objects as it's root.
-            int idx_of_game_data = gameDataFindArray(&token_data, &json_data_buff, "games");
-
-            // Progressively tokenize each object inside the array (making them appear as "root objects"), deserialize them and build the list
-            p_first_node = gameDataDeserializeGames(idx_of_game_data, &token_data, json_data_buff.p_buffer, json_data_buff.content_length);
-            // This is the easiest approach without modifying the way the deserialization code works
+            // Count the games of every date first, so they can all be deserialized into one array
+            const int num_games = gameDataDeserializeGames(&token_data, json_data_buff.p_buffer, NULL, NULL, 0);
+
+            gameDataObj_t *p_games = (num_games > 0) ? calloc(num_games, sizeof(gameDataObj_t)) : NULL;
+
+            // Keys found in each game, GAME_DATA_OBJ_NUM_KEYS per game
+            bool *p_found_keys = (num_games > 0) ? calloc((size_t)num_games * GAME_DATA_OBJ_NUM_KEYS, sizeof(bool)) : NULL;
+            if ((p_games != NULL) && (p_found_keys != NULL))
+            {
+#if (GAME_DATA_DESERIALIZER_BENCHMARK_ENABLED == 1)
+                gameDataBenchmarkDeserializers(&token_data, json_data_buff.p_buffer, p_games, p_found_keys, num_games);
+#endif
+#if (GAME_DATA_SYNTHETIC_BENCHMARK_ENABLED == 1)
+                gameDataBenchmarkSynthetic(p_parser);
+#endif
+#if (GAME_DATA_PARALLEL_DESERIALIZATION_ENABLED == 1)
+                // Share the games out to the worker pool when there are enough of them to be worth it
+                const int num_deserialized = (num_games >= GAME_DATA_PARALLEL_MIN_GAMES) ?
+                                             gameDataDeserializeGamesParallel(p_parser, &token_data,
+                                                                              json_data_buff.p_buffer, p_games,
+                                                                              p_found_keys, num_games) :
+                                             gameDataDeserializeGames(&token_data, json_data_buff.p_buffer,
+                                                                      p_games, p_found_keys, num_games);
+#else
+                // Fill in all of the games in a single pass over the tokens, each array of games in one go
+                const int num_deserialized = gameDataDeserializeGames(&token_data, json_data_buff.p_buffer,
+                                                                      p_games, p_found_keys, num_games);
+#endif
+#if (GAME_DATA_SERIALIZER_BENCHMARK_ENABLED == 1)
+                gameDataBenchmarkSerializer(p_games, p_found_keys, num_deserialized);
+#endif
+
+                // Everything the list needs is allocated out of its dataset
+                gameDataSet_t *const p_dataset = gameDataSetCreate((size_t)num_deserialized * GAME_DATA_LIST_BYTES_PER_GAME);
+                if (p_dataset != NULL)
+                {
+#if (GAME_DATA_ZERO_COPY_ENABLED == 1)
+                    // Keep the JSON document for the games to point into
+                    gameDataSetKeepJson(p_dataset, &json_data_buff);
+#endif
+
+                    // Turn the games into the list to be returned
+                    p_list->p_games = memArenaAlloc(&p_dataset->arena, ((size_t)num_deserialized * sizeof(gameData_t)));
+                    for (int idx = 0; (p_list->p_games != NULL) && (idx < num_deserialized); idx++)
+                    {
+                        // Games missing optional values are still listed, with those members left empty
+                        if ((gameDataCheckGameKeys(&p_found_keys[idx * GAME_DATA_OBJ_NUM_KEYS]) == APPERR_OK) &&
+                            gameDataDeserializeGame(&p_games[idx], &p_list->p_games[p_list->num_games], p_dataset,
+                                                    &p_dataset->arena, &p_parser->strings))
+                        {
+                            p_list->num_games++;
+                        }
+                    }
+
+                    gameDataSetFinish(p_parser, p_dataset, p_list);
+                }
+            }
+            free(p_games);
+            free(p_found_keys);
         }
 
-        // TODO: Remove this todo, only here to indicate that this was forgotton the the submission originally.
-        // TODO: OOPS! Free the token data, since it's no longer needed
-        gameDataFreeTokenData(&token_data);
+        // The tokens stay in the parser's arena, to be reused by the next gather
     }
+    // Nothing to free if the dataset took the buffer over
     curlLibFreeData(&json_data_buff);
-
-    // Hand the linked list of game objects back to the caller
-    return p_first_node;
 }
 
-// Free the list of game nodes, starting with the first
-// WARN: The first node must be passed into the function
-void gameDataParserGameListDestroy(gameDataNode_t *p_list)
+// Tokenizes and deserializes the games as the JSON document is being downloaded. Only the game
+// currently being received is ever held in memory.
+static void gameDataGatherStreamed(gameDataParser_t *const p_parser, const char *const p_json_url,
+                                   gameDataList_t *const p_list)
 {
-    // Not allowed to start freeing the list anywhere except the first node!
-    assert(p_list->prev == NULL);
+    // The number of games isn't known up front, the dataset's arena grows as they come in
+    gameDataStreamCtx_t stream_ctx = {.p_games = NULL, .num_games = 0, .capacity = 0, .p_dataset = gameDataSetCreate(0),
+                                      .p_strings = &p_parser->strings};
 
-    // Traverse through the linked list freeing each bit that was malloc'd until
-    // the next node is null
-    gameDataNode_t *p_current_node = p_list;
-    while(p_current_node != NULL)
+    if (stream_ctx.p_dataset != NULL)
     {
-        // Free the image data first
-        curlLibFreeData(p_current_node->p_data->p_img_data);
+        jsonStream_t stream;
+        jsonStreamInit(&stream, GAME_DATA_GAMES_ARRAY_PATH, g_p_game_filter, &p_parser->game_tokens[0],
+                       gameDataStreamGameCbk, &stream_ctx);
 
-        // Free all the members of the game data
-        free(p_current_node->p_data->home_team_name_str);
-        free(p_current_node->p_data->away_team_name_str);
-        free(p_current_node->p_data->detailed_state_str);
-        free(p_current_node->p_data->home_team_score_str);
-        free(p_current_node->p_data->away_team_score_str);
+        appErrors_t error_status = curlLibStreamData(p_json_url, gameDataStreamChunkCbk, &stream);
+        if ((error_status != APPERR_OK) || !jsonStreamFinish(&stream))
+        {
+            // Keep whatever games made it through, the list is just shorter
+            printf("Game data stream ended early, %d games parsed\n", stream.num_elements);
+        }
+        jsonStreamDestroy(&stream);
 
-        // Free the game data struct
-        free(p_current_node->p_data);
+        // Move the games into the dataset, along with everything they point to
+        p_list->p_games = (stream_ctx.num_games > 0) ?
+                          memArenaAlloc(&stream_ctx.p_dataset->arena, ((size_t)stream_ctx.num_games * sizeof(gameData_t))) :
+                          NULL;
+        if (p_list->p_games != NULL)
+        {
+            memcpy(p_list->p_games, stream_ctx.p_games, ((size_t)stream_ctx.num_games * sizeof(gameData_t)));
+            p_list->num_games = stream_ctx.num_games;
+        }
+        gameDataSetFinish(p_parser, stream_ctx.p_dataset, p_list);
+    }
+    free(stream_ctx.p_games);
+}
 
-        // Save the next node for traversal
-        gameDataNode_t* p_next_node = p_current_node->next;
+// Curl hands the received data over in chunks, feed those into the stream
+static bool gameDataStreamChunkCbk(void *p_ctx, const char *const p_chunk, const size_t chunk_len)
+{
+    return jsonStreamFeed((jsonStream_t *)p_ctx, p_chunk, chunk_len);
+}
 
-        // Free the linked list node
-        free(p_current_node);
+// Called by the stream for every completed game object
+static bool gameDataStreamGameCbk(void *p_ctx, const char *const p_element, const int element_len,
+                                  const jsmnTokenizationData_t *const p_tok_data)
+{
+    gameDataStreamCtx_t *const p_stream_ctx = (gameDataStreamCtx_t *)p_ctx;
 
-        // Traverse to the next node
-        p_current_node = p_next_node;
+    bool success = true;
+    if (p_stream_ctx->num_games == p_stream_ctx->capacity)
+    {
+        int new_capacity = (p_stream_ctx->capacity > 0) ? (p_stream_ctx->capacity * 2) : GAME_DATA_DEFAULT_NUM_STREAMED_GAMES;
+        gameData_t *p_new_games = realloc(p_stream_ctx->p_games, (new_capacity * sizeof(gameData_t)));
+        if (p_new_games != NULL)
+        {
+            p_stream_ctx->p_games = p_new_games;
+            p_stream_ctx->capacity = new_capacity;
+        }
+        else
+        {
+            success = false;
+        }
     }
-}
 
-/* *************************   Private Functions   ************************ */
+    // Anything other than an object in the array is ignored
+    if (success && (p_tok_data->num_tokens > 0) && (p_tok_data->p_tokens[0].type == JSMN_OBJECT))
+    {
+        // The game is copied out of the element's buffer, so it can be released after this
+        gameDataObj_t game_data_deserialized;
+        if ((gameDataDeserializeGameObj(p_tok_data, p_element, &game_data_deserialized) == APPERR_OK) &&
+            gameDataDeserializeGame(&game_data_deserialized, &p_stream_ctx->p_games[p_stream_ctx->num_games],
+                                    p_stream_ctx->p_dataset, &p_stream_ctx->p_dataset->arena, p_stream_ctx->p_strings))
+        {
+            p_stream_ctx->num_games++;
+        }
+    }
 
-// Utilizes jsmn JSON tokenizer to tokenize the json data
-static bool gameDataTokenizeJson(jsmnTokenizationData_t *const p_token_data,
-                                 const char *const p_json_buff,
-                                 const size_t json_content_length)
-{
-    // Init parser and token data struct
-    jsmn_parser parser;
-    memset(p_token_data, 0, sizeof(jsmnTokenizationData_t));
+    return success;
+}
 
-    // Malloc a token list to store the tokens
-    p_token_data->num_tokens = DEFAULT_NUM_TOKENS_TO_ALLOC;
-    p_token_data->p_tokens = calloc(p_token_data->num_tokens, sizeof(jsmntok_t));
+// Downloads the whole JSON document, locates every game in it and parses the games on several threads.
+// Unlike the buffered path, the document is never tokenized as a whole, only one game at a time.
+static void gameDataGatherParallel(gameDataParser_t *const p_parser, const char *const p_json_url,
+                                   gameDataList_t *const p_list)
+{
+    httpDataBuffer_t json_data_buff;
+    curlLibBufferInit(&json_data_buff);
+    appErrors_t error_status = curlLibGetData(&json_data_buff, p_json_url);
 
-    bool tokenization_failed = false;
-    if (p_token_data->p_tokens != NULL)
+    if (error_status == APPERR_OK)
     {
-        // Attempt to tokenize the json data, increasing the number of tokens available if needed.
-        int jsmn_result;
-        do
+        // Scan for the start and end of each game, this only looks at brackets and quotes
+        gameDataSpanList_t span_list = {.p_spans = NULL, .num_spans = 0, .capacity = 0};
+        jsonStream_t stream;
+        jsonStreamInitSpans(&stream, GAME_DATA_GAMES_ARRAY_PATH, gameDataSpanCbk, &span_list);
+        bool result = jsonStreamFeed(&stream, json_data_buff.p_buffer, json_data_buff.content_length) &&
+                      jsonStreamFinish(&stream);
+        jsonStreamDestroy(&stream);
+
+        if (result)
         {
-            jsmn_init(&parser);
-            jsmn_result = jsmn_parse(&parser, p_json_buff, json_content_length, p_token_data->p_tokens, p_token_data->num_tokens);
-            if (jsmn_result == JSMN_ERROR_NOMEM)
-            {
-                // Double the number of tokens and try again to tokenize
-                p_token_data->num_tokens *= 2;
-                free(p_token_data->p_tokens);
-                p_token_data->p_tokens = calloc(p_token_data->num_tokens, sizeof(jsmntok_t));
-                tokenization_failed = (p_token_data->p_tokens == NULL);
-            }
-            else if (jsmn_result < 0)
-            {
-                // All other JSMN errors are unrecoverable at this point and cause the tokenization to fail
-                tokenization_failed = true;
-            }
-            else
+#if (GAME_DATA_PARALLEL_BENCHMARK_ENABLED == 1)
+            gameDataBenchmarkParallel(p_parser, json_data_buff.p_buffer, &span_list);
+#endif
+            gameDataSet_t *const p_dataset = gameDataSetCreate((size_t)span_list.num_spans * GAME_DATA_LIST_BYTES_PER_GAME);
+            if (p_dataset != NULL)
             {
-                // The result is the number of actual parsed tokens.
-                p_token_data->num_tokens = jsmn_result;
+                // Stays where it is if the dataset takes the buffer over
+                const char *const p_json_buff = json_data_buff.p_buffer;
+#if (GAME_DATA_ZERO_COPY_ENABLED == 1)
+                // The games are only ever tokenized within their own span, so each one can point into the
+                // document as soon as it's deserialized
+                gameDataSetKeepJson(p_dataset, &json_data_buff);
+#endif
+                // Every game has a slot, games that can't be built are squeezed out afterwards
+                p_list->p_games = memArenaAlloc(&p_dataset->arena, ((size_t)span_list.num_spans * sizeof(gameData_t)));
+                if (p_list->p_games != NULL)
+                {
+                    p_list->num_games = gameDataParseGamesParallel(p_parser, p_json_buff, &span_list,
+                                                                   GAME_DATA_NUM_PARSE_THREADS, p_dataset, p_list->p_games);
+                }
+                gameDataSetFinish(p_parser, p_dataset, p_list);
             }
-        } while ((!tokenization_failed) && (jsmn_result < 0));
+        }
+
+        free(span_list.p_spans);
     }
-    else
+    curlLibFreeData(&json_data_buff);
+}
+
+// Called by the stream with the location of every game in the document
+static bool gameDataSpanCbk(void *p_ctx, const size_t element_start, const size_t element_len)
+{
+    gameDataSpanList_t *const p_span_list = (gameDataSpanList_t *)p_ctx;
+
+    bool success = true;
+    if (p_span_list->num_spans == p_span_list->capacity)
+    {
+        int new_capacity = (p_span_list->capacity > 0) ? (p_span_list->capacity * 2) : GAME_DATA_DEFAULT_NUM_SPANS;
+        gameDataSpan_t *p_new_spans = realloc(p_span_list->p_spans, (new_capacity * sizeof(gameDataSpan_t)));
+        if (p_new_spans != NULL)
+        {
+            p_span_list->p_spans = p_new_spans;
+            p_span_list->capacity = new_capacity;
+        }
+        else
+        {
+            success = false;
+        }
+    }
+
+    if (success)
     {
-        tokenization_failed = true;
+        p_span_list->p_spans[p_span_list->num_spans].start = element_start;
+        p_span_list->p_spans[p_span_list->num_spans].len = element_len;
+        p_span_list->num_spans++;
     }
 
-    return !(tokenization_failed);
+    return success;
 }
 
-// Frees the token list that was allocated
-static void gameDataFreeTokenData(jsmnTokenizationData_t *const p_token_data)
+// Splits the games into one contiguous range per thread, parses the ranges at the same time on the worker pool,
+// then moves the games each range built down behind the ones of the range before, so they are in document order.
+// The games are built into `p_games` (one slot per span) and allocated out of `p_dataset`. Returns the number of
+// games built. Without an array of games, the games are only deserialized.
+static int gameDataParseGamesParallel(gameDataParser_t *const p_parser, const char *const p_json_buff,
+                                      const gameDataSpanList_t *const p_span_list, const int num_threads,
+                                      gameDataSet_t *const p_dataset, gameData_t *const p_games)
 {
-    free(p_token_data->p_tokens);
-}
+    assert((num_threads > 0) && (num_threads <= GAME_DATA_NUM_PARSE_THREADS));
+    assert((p_games == NULL) || (p_dataset != NULL));
 
-// NOTE: This could enforce that "games" is a child of "dates", since "dates" is the child of the parent object
-// NOTE: but for now this lazy approach should work (barring no second "games" array shows up in the data).
-//
-// Searches the token list for the named array.
-// Returns an index of the token in the list for the corresponding array
-static int gameDataFindArray(const jsmnTokenizationData_t *const p_tok_data, const httpDataBuffer_t *const p_buff,
-                             const char *const key_of_array_str)
-{
-    bool at_buffer_end = false;
-    bool matching_token_found = false;
+    gameDataParseRange_t ranges[GAME_DATA_NUM_PARSE_THREADS];
+
+    // Spread the remainder over the first ranges, so no two ranges differ by more than one game
+    int games_per_range = (p_span_list->num_spans / num_threads);
+    int remainder = (p_span_list->num_spans % num_threads);
+    int next_game_idx = 0;
+    for (int idx = 0; idx < num_threads; idx++)
+    {
+        ranges[idx].p_json_buff = p_json_buff;
+        ranges[idx].p_spans = &p_span_list->p_spans[next_game_idx];
+        ranges[idx].num_games = games_per_range + ((idx < remainder) ? 1 : 0);
+        ranges[idx].p_token_arena = &p_parser->game_tokens[idx];
+        ranges[idx].p_games = (p_games != NULL) ? &p_games[next_game_idx] : NULL;
+        ranges[idx].num_built = 0;
+        ranges[idx].p_dataset = p_dataset;
+        memArenaInit(&ranges[idx].list_arena, 0);
+        ranges[idx].p_strings = &p_parser->strings;
+        next_game_idx += ranges[idx].num_games;
+    }
+
+    // One job per range, each range has its own token arena whichever worker it ends up on
+    gameDataStartWorkers(p_parser);
+    workerPoolRun(&p_parser->workers, gameDataParseRangeJob, ranges, num_threads);
 
-    // This will be the index where the game data is found
-    int token_idx = 0;
-    while ((token_idx < p_tok_data->num_tokens) && !matching_token_found)
+    // Close the gaps left by games that couldn't be built
+    int num_games = 0;
+    for (int idx = 0; idx < num_threads; idx++)
     {
-        // The token must be at least beyond the first token, otherwise it can't be a named array
-        if (p_tok_data->p_tokens[token_idx].type == JSMN_ARRAY && token_idx > 0)
+        if (p_dataset != NULL)
         {
-            // Check the key token, which is the token before the current, to see if the string matches
-            const jsmntok_t *const p_tok = &p_tok_data->p_tokens[token_idx - 1];
-            // Catch access that will be out of bounds; This should never happen
-            assert(p_buff->content_length > (p_tok->start + p_tok->size));
-
-            const char *const key_str = p_buff->p_buffer + p_tok->start;
-            matching_token_found = (p_tok->type == JSMN_STRING) &&
-                                   (strncmp(key_str, key_of_array_str, p_tok->size) == 0);
+            memArenaAppend(&p_dataset->arena, &ranges[idx].list_arena);
         }
 
-        if (!matching_token_found)
+        if (ranges[idx].num_built > 0)
         {
-            token_idx++;
+            memmove(&p_games[num_games], ranges[idx].p_games, ((size_t)ranges[idx].num_built * sizeof(gameData_t)));
+            num_games += ranges[idx].num_built;
         }
     }
 
-    return (matching_token_found ? token_idx : -1);
+    return num_games;
 }
 
-// Creates a linked list of game data and hands back the first item in the list to the caller
-static gameDataNode_t *gameDataDeserializeGames(const int game_array_idx, const jsmnTokenizationData_t *const p_token_data,
-                                                const char *const p_json_buff, const size_t json_content_length)
+// Worker pool job, tokenizes and deserializes each game of a range, building the games into the range's slots
+static void gameDataParseRangeJob(void *p_ctx, const int job_idx, const int worker_idx)
 {
-    // Determine the number of games by the size of the ARRAY token
-    int num_games = p_token_data->p_tokens[game_array_idx].size;
+    gameDataParseRange_t *const p_range = &((gameDataParseRange_t *)p_ctx)[job_idx];
 
-    // Declare pointer that will point to the linked list
-    gameDataNode_t *current_node = NULL;
+    for (int idx = 0; idx < p_range->num_games; idx++)
+    {
+        const char *const obj_start_char = (p_range->p_json_buff + p_range->p_spans[idx].start);
+
+        jsmnTokenizationData_t game_obj_token_data;
+        if (jsonTokenArenaTokenize(p_range->p_token_arena, obj_start_char, p_range->p_spans[idx].len,
+                                   g_p_game_filter, &game_obj_token_data) &&
+            (game_obj_token_data.num_tokens > 0) && (game_obj_token_data.p_tokens[0].type == JSMN_OBJECT))
+        {
+            gameDataObj_t game_data_deserialized;
+            const bool game_valid = (gameDataDeserializeGameObj(&game_obj_token_data, obj_start_char,
+                                                                &game_data_deserialized) == APPERR_OK);
+
+            if ((p_range->p_games != NULL) && game_valid &&
+                gameDataDeserializeGame(&game_data_deserialized, &p_range->p_games[p_range->num_built],
+                                        p_range->p_dataset, &p_range->list_arena, p_range->p_strings))
+            {
+                p_range->num_built++;
+            }
+        }
+    }
+}
 
-    // Iterate through all the games
-    int next_game_tok_idx = (game_array_idx + 1);
-    for (int idx = 0; idx < num_games; idx++)
+// Times the parallel parse of the games with an increasing number of threads and prints out the scaling
+static void gameDataBenchmarkParallel(gameDataParser_t *const p_parser, const char *const p_json_buff,
+                                      const gameDataSpanList_t *const p_span_list)
+{
+    double single_thread_ms = 0.0;
+    printf("Parallel parse of %d games, %d iterations\n", p_span_list->num_spans, GAME_DATA_BENCHMARK_ITERATIONS);
+
+    for (int num_threads = 1; num_threads <= GAME_DATA_NUM_PARSE_THREADS; num_threads++)
     {
+        Uint64 start_count = SDL_GetPerformanceCounter();
+        for (int iteration = 0; iteration < GAME_DATA_BENCHMARK_ITERATIONS; iteration++)
+        {
+            gameDataParseGamesParallel(p_parser, p_json_buff, p_span_list, num_threads, NULL, NULL);
+        }
+        Uint64 elapsed_count = SDL_GetPerformanceCounter() - start_count;
 
-        // Check the next token, it should be an object token with a parent idx equal to game_array_idx
-        if ((next_game_tok_idx < p_token_data->num_tokens) &&
-            (p_token_data->p_tokens[next_game_tok_idx].parent == game_array_idx))
+        double parse_ms = ((double)elapsed_count * 1000.0) /
+                          ((double)SDL_GetPerformanceFrequency() * GAME_DATA_BENCHMARK_ITERATIONS);
+        if (num_threads == 1)
         {
-            jsmntok_t *p_game_obj_tok = &p_token_data->p_tokens[next_game_tok_idx];
+            single_thread_ms = parse_ms;
+        }
+        printf("  %d thread(s): %.3f ms, %.2fx\n", num_threads, parse_ms,
+               ((parse_ms > 0.0) ? (single_thread_ms / parse_ms) : 0.0));
+    }
+}
 
-            // If this is true, tokenize this object, create a new buffer that points to the object start
-            // then pass it off to be deserialized
-            jsmnTokenizationData_t game_obj_token_data;
-            const char *const obj_start_char = (p_json_buff + p_game_obj_tok->start);
-            const int obj_len = p_game_obj_tok->end - p_game_obj_tok->start;
-            bool result = gameDataTokenizeJson(&game_obj_token_data, obj_start_char, obj_len);
+// Times the deserialization of all of the games in the document, with the generated deserializer and with the
+// generic one going through the key table, and prints out the results
+static void gameDataBenchmarkDeserializers(const jsmnTokenizationData_t *const p_tok_data, const char *const p_json_buff,
+                                           gameDataObj_t *const p_games, bool *const p_found_keys, const int num_games)
+{
+    jsonObjectDeserializer_t *const p_configured = g_game_obj_container.p_deserializer;
+    jsonObjectDeserializer_t *const deserializers[] = {gameDataObjDeserialize, NULL};
+    const char *const labels[] = {"Generated", "Generic"};
 
-            // Find the value token that matches the desired element and deserialize the game data
-            gameDataObj_t game_data_deserialized;
-            memset(&game_data_deserialized, 0, sizeof(gameDataObj_t));
-            for (int jdx = 0; jdx < ARRAY_SIZE(g_list_of_game_obj_values); jdx++)
+    for (uint32_t idx = 0; idx < ARRAY_SIZE(deserializers); idx++)
+    {
+        g_game_obj_container.p_deserializer = deserializers[idx];
+
+        int num_deserialized = 0;
+        Uint64 start_count = SDL_GetPerformanceCounter();
+        for (int iteration = 0; iteration < GAME_DATA_BENCHMARK_ITERATIONS; iteration++)
+        {
+            num_deserialized = gameDataDeserializeGames(p_tok_data, p_json_buff, p_games, p_found_keys, num_games);
+        }
+        Uint64 elapsed_count = SDL_GetPerformanceCounter() - start_count;
+
+        double deserialize_us = ((double)elapsed_count * 1000000.0) /
+                                ((double)SDL_GetPerformanceFrequency() * GAME_DATA_BENCHMARK_ITERATIONS);
+        printf("%s deserializer: %.2f us, %d games\n", labels[idx], deserialize_us, num_deserialized);
+    }
+
+    g_game_obj_container.p_deserializer = p_configured;
+}
+
+// Builds a document of GAME_DATA_SYNTHETIC_NUM_GAMES generated games, times its games being deserialized serially
+// and in parallel, checks that both give the same games, and prints out the results
+static void gameDataBenchmarkSynthetic(gameDataParser_t *const p_parser)
+{
+    // Game objects shaped like the ones of the schedule feed, with a few of the keys that are not deserialized
+    static const char game_format[] =
+        "{\"gamePk\":%d,\"link\":\"/api/v1.1/game/%d/feed/live\",\"gameType\":\"R\",\"season\":\"2018\","
+        "\"gameDate\":\"2018-06-%02dT17:05:00Z\","
+        "\"status\":{\"abstractGameState\":\"Final\",\"codedGameState\":\"F\",\"detailedState\":\"%s\"},"
+        "\"teams\":{\"away\":{\"leagueRecord\":{\"wins\":%d,\"losses\":%d},\"score\":%d,"
+        "\"team\":{\"id\":%d,\"name\":\"%s\"},\"isWinner\":false},"
+        "\"home\":{\"leagueRecord\":{\"wins\":%d,\"losses\":%d},\"score\":%d,"
+        "\"team\":{\"id\":%d,\"name\":\"%s\"},\"isWinner\":true}},"
+        "\"venue\":{\"id\":%d,\"name\":\"Stadium %d\"}%s}";
+    static const char content_format[] =
+        ",\"content\":{\"editorial\":{\"recap\":{\"home\":{\"headline\":\"Recap %d\","
+        "\"photo\":{\"cuts\":{\"480x270\":{\"width\":480,\"height\":270,"
+        "\"src\":\"https://img.example.com/%d/480x270.jpg\"}}}}}}}";
+    static const char *const team_names[] =
+        {"New York Yankees", "Boston Red Sox", "Montr\\u00e9al \\\"Expos\\\"", "Chicago Cubs", "Los Angeles Dodgers"};
+    static const char *const states[] = {"Final", "In Progress", "Postponed"};
+    static const char doc_start[] = "{\"dates\":[{\"games\":[";
+    static const char doc_end[] = "]}]}";
+
+    const size_t max_game_len = 1024;
+    const size_t max_doc_len = (sizeof(doc_start) + sizeof(doc_end) + (GAME_DATA_SYNTHETIC_NUM_GAMES * max_game_len));
+    char *const p_doc = malloc(max_doc_len);
+    gameDataObj_t *const p_serial = calloc(GAME_DATA_SYNTHETIC_NUM_GAMES, sizeof(gameDataObj_t));
+    gameDataObj_t *const p_parallel = calloc(GAME_DATA_SYNTHETIC_NUM_GAMES, sizeof(gameDataObj_t));
+    bool *const p_serial_keys = calloc(GAME_DATA_SYNTHETIC_NUM_GAMES * GAME_DATA_OBJ_NUM_KEYS, sizeof(bool));
+    bool *const p_parallel_keys = calloc(GAME_DATA_SYNTHETIC_NUM_GAMES * GAME_DATA_OBJ_NUM_KEYS, sizeof(bool));
+
+    jsonTokenArena_t synthetic_tokens;
+    jsonTokenArenaInit(&synthetic_tokens);
+
+    if ((p_doc != NULL) && (p_serial != NULL) && (p_parallel != NULL) && (p_serial_keys != NULL) &&
+        (p_parallel_keys != NULL))
+    {
+        // {"dates":[{"games":[<game>,<game>,...]}]}, every postponed game is missing its recap
+        size_t doc_len = (sizeof(doc_start) - 1);
+        memcpy(p_doc, doc_start, doc_len);
+        for (int idx = 0; idx < GAME_DATA_SYNTHETIC_NUM_GAMES; idx++)
+        {
+            const char *const p_state = states[idx % ARRAY_SIZE(states)];
+            const int num_teams = (int)ARRAY_SIZE(team_names);
+            char content[256] = "";
+            if (strcmp(p_state, "Postponed") != 0)
             {
-                const jsonKeyValue_t *const p_value_data = &g_list_of_game_obj_values[jdx];
-                int value_tok_idx = jsonSearchForElement(&game_obj_token_data, obj_start_char, p_value_data);
+                snprintf(content, sizeof(content), content_format, idx, idx);
+            }
+
+            if (idx > 0)
+            {
+                p_doc[doc_len++] = ',';
+            }
+            const int game_len = snprintf(&p_doc[doc_len], (max_game_len - 1), game_format,
+                                          idx, idx, ((idx % 30) + 1), p_state,
+                                          (idx % 100), (idx % 90), (idx % 13), (idx % num_teams),
+                                          team_names[idx % num_teams],
+                                          (idx % 95), (idx % 85), (idx % 11), ((idx + 1) % num_teams),
+                                          team_names[(idx + 1) % num_teams], (idx % 30), (idx % 30), content);
+            doc_len += (size_t)game_len;
+        }
+        memcpy(&p_doc[doc_len], doc_end, (sizeof(doc_end) - 1));
+        doc_len += (sizeof(doc_end) - 1);
 
-                // Game objects should always contain the specified elements. If not, something is wrong.
-                assert(value_tok_idx > 0);
-                if (value_tok_idx > 0)
+        jsmnTokenizationData_t synthetic_tok_data;
+        if (jsonTokenArenaTokenize(&synthetic_tokens, p_doc, doc_len, g_p_document_filter, &synthetic_tok_data))
+        {
+            int num_serial = 0;
+            int num_parallel = 0;
+            double serial_ms = 0.0;
+            double parallel_ms = 0.0;
+            for (int mode = 0; mode < 2; mode++)
+            {
+                Uint64 start_count = SDL_GetPerformanceCounter();
+                for (int iteration = 0; iteration < GAME_DATA_BENCHMARK_ITERATIONS; iteration++)
                 {
-                    // Index of token was found, go deserialize into data struct.
-                    jsonDeserializeElement(p_value_data, &game_obj_token_data.p_tokens[value_tok_idx],
-                                           obj_start_char, &game_data_deserialized);
+                    if (mode == 0)
+                    {
+                        num_serial = gameDataDeserializeGames(&synthetic_tok_data, p_doc, p_serial, p_serial_keys,
+                                                              GAME_DATA_SYNTHETIC_NUM_GAMES);
+                    }
+                    else
+                    {
+                        num_parallel = gameDataDeserializeGamesParallel(p_parser, &synthetic_tok_data, p_doc,
+                                                                        p_parallel, p_parallel_keys,
+                                                                        GAME_DATA_SYNTHETIC_NUM_GAMES);
+                    }
                 }
+                Uint64 elapsed_count = SDL_GetPerformanceCounter() - start_count;
+
+                double elapsed_ms = ((double)elapsed_count * 1000.0) /
+                                    ((double)SDL_GetPerformanceFrequency() * GAME_DATA_BENCHMARK_ITERATIONS);
+                serial_ms = (mode == 0) ? elapsed_ms : serial_ms;
+                parallel_ms = (mode == 1) ? elapsed_ms : parallel_ms;
             }
 
-            // Turn datastruct into linked list object to be returned
-            current_node = gameDataDeserializeGame(&game_data_deserialized, current_node);
+            bool identical = (num_serial == num_parallel) &&
+                             (memcmp(p_serial_keys, p_parallel_keys,
+                                     (size_t)num_serial * GAME_DATA_OBJ_NUM_KEYS * sizeof(bool)) == 0);
+            for (int idx = 0; (idx < num_serial) && identical; idx++)
+            {
+                identical = gameDataGamesEqual(&p_serial[idx], &p_parallel[idx]);
+            }
 
-            // Free the JSON tokens after deserialization is finished
-            gameDataFreeTokenData(&game_obj_token_data);
+            printf("Synthetic document of %d games (%zu bytes), %d iterations\n", num_serial, doc_len,
+                   GAME_DATA_BENCHMARK_ITERATIONS);
+            printf("  Serial: %.3f ms\n", serial_ms);
+            printf("  Parallel, %d thread(s): %.3f ms, %.2fx, %s\n", workerPoolNumThreads(&p_parser->workers),
+                   parallel_ms, ((parallel_ms > 0.0) ? (serial_ms / parallel_ms) : 0.0),
+                   (identical ? "same games" : "GAMES DIFFER"));
         }
+    }
+
+    jsonTokenArenaDestroy(&synthetic_tokens);
+    free(p_parallel_keys);
+    free(p_serial_keys);
+    free(p_parallel);
+    free(p_serial);
+    free(p_doc);
+}
+
+// Compares two deserialized games value by value. Strings are compared by their text, since the same string can be
+// decoded into different caches.
+static bool gameDataGamesEqual(const gameDataObj_t *const p_game_a, const gameDataObj_t *const p_game_b)
+{
+    bool equal = true;
+    for (int idx = 0; (idx < GAME_DATA_OBJ_NUM_KEYS) && equal; idx++)
+    {
+        const jsonKeyValue_t *const p_key = &g_list_of_game_obj_values[idx];
+        const uint8_t *const p_value_a = ((const uint8_t *)p_game_a + p_key->struct_member_offset);
+        const uint8_t *const p_value_b = ((const uint8_t *)p_game_b + p_key->struct_member_offset);
 
-        // Find the next game object
-        do
+        if (p_key->c_type == E_JSON_C_STR_PTR)
+        {
+            const jsonStr_t *const p_str_a = (const jsonStr_t *)p_value_a;
+            const jsonStr_t *const p_str_b = (const jsonStr_t *)p_value_b;
+            equal = (p_str_a->len == p_str_b->len) &&
+                    ((p_str_a->len == 0) || (memcmp(p_str_a->str, p_str_b->str, p_str_a->len) == 0));
+        }
+        else
         {
-            next_game_tok_idx++;
-        } while ((next_game_tok_idx < p_token_data->num_tokens) &&
-                 (p_token_data->p_tokens[next_game_tok_idx].parent != game_array_idx));
+            equal = (memcmp(p_value_a, p_value_b, p_key->struct_member_size) == 0);
+        }
     }
 
-    // Find the first node
-    while(current_node != NULL && current_node->prev != NULL){
-        current_node = current_node->prev;
+    return equal;
+}
+
+// Times the games being written back out as a JSON array, prints the throughput, and checks that deserializing the
+// text gives back the same games
+static void gameDataBenchmarkSerializer(const gameDataObj_t *const p_games, const bool *const p_found_keys,
+                                        const int num_games)
+{
+    jsonWriteBuffer_t json_out;
+    jsonWriteBufferInit(&json_out);
+
+    // Only the keys that were found in each game are written, so games missing optional values read back the same
+    g_game_obj_container.p_elements_to_serialize = (bool *)p_found_keys;
+
+    Uint64 start_count = SDL_GetPerformanceCounter();
+    for (int iteration = 0; iteration < GAME_DATA_BENCHMARK_ITERATIONS; iteration++)
+    {
+        jsonWriteBufferReset(&json_out);
+        jsonSerializeArray(&g_game_obj_serializer, p_games, sizeof(gameDataObj_t), num_games, &json_out);
+    }
+    Uint64 elapsed_count = SDL_GetPerformanceCounter() - start_count;
+    g_game_obj_container.p_elements_to_serialize = NULL;
+
+    double serialize_us = ((double)elapsed_count * 1000000.0) /
+                          ((double)SDL_GetPerformanceFrequency() * GAME_DATA_BENCHMARK_ITERATIONS);
+    printf("Serializer: %d games, %zu bytes, %.2f us, %.1f MB/s\n", num_games, json_out.len, serialize_us,
+           ((serialize_us > 0.0) ? ((double)json_out.len / serialize_us) : 0.0));
+
+    // Read the text back, as an array of games
+    jsonTokenArena_t round_trip_tokens;
+    jsonTokenArenaInit(&round_trip_tokens);
+    gameDataObj_t *const p_round_trip = (num_games > 0) ? calloc(num_games, sizeof(gameDataObj_t)) : NULL;
+    bool *const p_round_trip_keys = (num_games > 0) ? calloc((size_t)num_games * GAME_DATA_OBJ_NUM_KEYS, sizeof(bool)) : NULL;
+
+    jsmnTokenizationData_t round_trip_tok_data;
+    bool identical = !json_out.overflowed && (p_round_trip != NULL) && (p_round_trip_keys != NULL) &&
+                     jsonTokenArenaTokenize(&round_trip_tokens, json_out.p_buffer, json_out.len, NULL,
+                                            &round_trip_tok_data);
+    if (identical)
+    {
+        g_game_obj_container.p_deserialized_elements = p_round_trip_keys;
+        const int num_read = jsonDeserializeArray(&g_game_obj_schema, &round_trip_tok_data, json_out.p_buffer, 0,
+                                                  p_round_trip, sizeof(gameDataObj_t), num_games);
+        g_game_obj_container.p_deserialized_elements = NULL;
+
+        identical = (num_read == num_games) &&
+                    (memcmp(p_found_keys, p_round_trip_keys,
+                            (size_t)num_games * GAME_DATA_OBJ_NUM_KEYS * sizeof(bool)) == 0);
+        for (int idx = 0; (idx < num_games) && identical; idx++)
+        {
+            identical = gameDataGamesEqual(&p_games[idx], &p_round_trip[idx]);
+        }
     }
+    printf("  Round trip: %s\n", (identical ? "same games" : "GAMES DIFFER"));
 
-    return current_node;
+    free(p_round_trip_keys);
+    free(p_round_trip);
+    jsonTokenArenaDestroy(&round_trip_tokens);
+    jsonWriteBufferDestroy(&json_out);
 }
 
-// Expects to be passed a token belonging to the beginning of the object inside the named "game" array
-static gameDataNode_t *gameDataDeserializeGame(const gameDataObj_t *p_game_data_obj, gameDataNode_t *p_prev_node)
+// Compiles the game object key table into the trie used to deserialize each game, the game object container
+// into its schema and serializer, the paths to the games into expressions, and the key table into the path filters
+// used while tokenizing. Only done once.
+static void gameDataInitPaths(void)
 {
-    gameDataNode_t *p_node = malloc(sizeof(gameDataNode_t));
+    if (!g_game_obj_trie_initialized)
+    {
+        bool trie_valid = jsonPathTrieInit(&g_game_obj_trie, g_list_of_game_obj_values,
+                                           ARRAY_SIZE(g_list_of_game_obj_values));
 
-    if (p_node != NULL)
+        // The table has outgrown the trie, increase JSON_PATH_TRIE_MAX_NODES or JSON_MAX_PATH_SEGMENTS
+        assert(trie_valid);
+        g_game_obj_trie_initialized = true;
+    }
+
+    if (!g_game_obj_schema_initialized)
     {
-        // Clear out the dataspace to ensure no garbage in the pointers
-        memset(p_node, 0, sizeof(gameDataNode_t));
+        bool schema_valid = jsonSchemaInit(&g_game_obj_schema, &g_game_obj_container);
+        bool expr_valid = jsonPathExprInit(&g_games_arrays_expr, GAME_DATA_GAMES_ARRAYS_EXPR) &&
+                          jsonPathExprInit(&g_games_expr, GAME_DATA_GAMES_EXPR);
+
+        // The container has outgrown the schema (increase JSON_SCHEMA_MAX_NODES), or the expression is malformed
+        assert(schema_valid && expr_valid);
 
-        // Set the previous node to the one specified (even if null)
-        p_node->prev = p_prev_node;
-        if (p_prev_node != NULL)
+        // The keys have outgrown the serializer, increase JSON_SERIALIZER_MAX_KEY_BYTES
+        bool serializer_valid = jsonSerializerInit(&g_game_obj_serializer, &g_game_obj_container);
+        assert(serializer_valid);
+
+        g_game_obj_schema_initialized = true;
+    }
+
+#if (GAME_DATA_FILTERED_TOKENIZATION_ENABLED == 1)
+    static jsonPathFilter_t document_filter;
+    static jsonPathFilter_t game_filter;
+
+    if (g_p_document_filter == NULL)
+    {
+        // If the table ever outgrows the filter, fall back to tokenizing everything
+        if (jsonPathFilterInit(&document_filter, GAME_DATA_GAMES_ARRAY_PATH,
+                               g_list_of_game_obj_values, ARRAY_SIZE(g_list_of_game_obj_values)) &&
+            jsonPathFilterInit(&game_filter, NULL,
+                               g_list_of_game_obj_values, ARRAY_SIZE(g_list_of_game_obj_values)))
         {
-            // If there is a previous node, set it to this one
-            p_prev_node->next = p_node;
+            g_p_document_filter = &document_filter;
+            g_p_game_filter = &game_filter;
         }
-        // Set the next node to null, since there is no next node
-        p_node->next = NULL;
+    }
+#endif
+}
+
+// Deserializes the games of every array of games in the document, one after the other into p_games, in a single
+// pass over the tokens. When p_games is NULL, the games are only counted.
+// p_found_keys[out]: Keys found in each game, GAME_DATA_OBJ_NUM_KEYS per game
+// Returns the number of games deserialized (or counted).
+static int gameDataDeserializeGames(const jsmnTokenizationData_t *const p_tok_data, const char *const p_json_buff,
+                                    gameDataObj_t *const p_games, bool *const p_found_keys, const int max_games)
+{
+    gameDataGamesDest_t games_dest =
+        {
+            .p_json_buff = p_json_buff,
+            .p_games = p_games,
+            .p_found_keys = p_found_keys,
+            .max_games = max_games,
+            .num_games = 0,
+        };
+    jsonPathExprSearch(&g_games_arrays_expr, p_tok_data, p_json_buff, JSMN_ARRAY, gameDataGamesArrayCbk, &games_dest);
+
+    // The found keys belong to the caller, don't keep pointing into them
+    g_game_obj_container.p_deserialized_elements = NULL;
+    return games_dest.num_games;
+}
+
+// Path expression match callback, called for each array of games
+static bool gameDataGamesArrayCbk(void *p_ctx, const jsmnTokenizationData_t *const p_tok_data, const int tok_idx)
+{
+    gameDataGamesDest_t *const p_dest = (gameDataGamesDest_t *)p_ctx;
+
+    if (p_dest->p_games == NULL)
+    {
+        p_dest->num_games += p_tok_data->p_tokens[tok_idx].size;
+    }
+    else
+    {
+        // The games of this array follow the games of the arrays before it
+        const int first_game = p_dest->num_games;
+        g_game_obj_container.p_deserialized_elements = &p_dest->p_found_keys[first_game * GAME_DATA_OBJ_NUM_KEYS];
+        p_dest->num_games += jsonDeserializeArray(&g_game_obj_schema, p_tok_data, p_dest->p_json_buff, tok_idx,
+                                                  &p_dest->p_games[first_game], sizeof(gameDataObj_t),
+                                                  (p_dest->max_games - first_game));
+    }
+
+    return true;
+}
+
+// Starts the parser's worker pool, the first time it is needed
+static void gameDataStartWorkers(gameDataParser_t *const p_parser)
+{
+    if (!p_parser->workers_started)
+    {
+        workerPoolInit(&p_parser->workers, GAME_DATA_NUM_PARSE_THREADS);
+        p_parser->workers_started = true;
+    }
+}
 
-        // allocate the space for the game data and start to populate
-        p_node->p_data = malloc(sizeof(gameData_t));
+// Same as gameDataDeserializeGames(), with the games shared out to the worker pool in chunks. Each game is written
+// to the slot of its position in the document, so the games are in the same order as when deserialized serially.
+// Strings that needed decoding point into the string caches of the workers, until the next parallel deserialization.
+// Returns the number of games deserialized.
+static int gameDataDeserializeGamesParallel(gameDataParser_t *const p_parser, const jsmnTokenizationData_t *const p_tok_data,
+                                            const char *const p_json_buff, gameDataObj_t *const p_games,
+                                            bool *const p_found_keys, const int max_games)
+{
+    gameDataGameToks_t game_toks =
+        {
+            .p_toks = (max_games > 0) ? malloc(max_games * sizeof(int)) : NULL,
+            .max_games = max_games,
+            .num_games = 0,
+        };
+
+    int num_deserialized = 0;
+    if (game_toks.p_toks != NULL)
+    {
+        // Find every game first, so each one has its slot before any job starts
+        jsonPathExprSearch(&g_games_expr, p_tok_data, p_json_buff, JSMN_OBJECT, gameDataGameTokCbk, &game_toks);
 
-        if (p_node->p_data != NULL)
+        gameDataStartWorkers(p_parser);
+        for (int idx = 0; idx < GAME_DATA_NUM_PARSE_THREADS; idx++)
         {
-            // Set the variables in the game data that do not need to be malloc'd
-            strncpy_s(p_node->p_data->date_str, ARRAY_SIZE(p_node->p_data->date_str), p_game_data_obj->game_date.str, p_game_data_obj->game_date.len);
-
-            // Malloc the strings
-            // NOTE: jsonStr_t.len does NOT account for the NULL byte, it is simply the length of the character data (hence the additional byte)
-            p_node->p_data->home_team_name_str = malloc(p_game_data_obj->home_team_name.len + 1);
-            p_node->p_data->away_team_name_str = malloc(p_game_data_obj->away_team_name.len + 1);
-            p_node->p_data->detailed_state_str = malloc(p_game_data_obj->detailed_state.len + 1);
-
-            // Malloc data for the scores
-            p_node->p_data->home_team_score_str = malloc(MAX_UINT32_STR_LEN);
-            p_node->p_data->away_team_score_str = malloc(MAX_UINT32_STR_LEN);
-
-            // Malloc the space for the image
-            char *img_url_str = malloc(p_game_data_obj->img_url.len + 1); // Img URL is going to be used to download the image
-            httpDataBuffer_t *p_img_buff = malloc(sizeof(httpDataBuffer_t));
-
-            if (p_node->p_data->home_team_name_str != NULL &&
-                p_node->p_data->away_team_name_str != NULL &&
-                p_node->p_data->home_team_score_str != NULL &&
-                p_node->p_data->away_team_score_str != NULL &&
-                p_node->p_data->detailed_state_str != NULL &&
-                img_url_str != NULL &&
-                p_img_buff != NULL)
-            {
-                // Copy all the data into the allocated string space.
-                strncpy_s(p_node->p_data->home_team_name_str, (p_game_data_obj->home_team_name.len + 1), p_game_data_obj->home_team_name.str, p_game_data_obj->home_team_name.len);
-                strncpy_s(p_node->p_data->away_team_name_str, (p_game_data_obj->away_team_name.len + 1), p_game_data_obj->away_team_name.str, p_game_data_obj->away_team_name.len);
-                strncpy_s(p_node->p_data->detailed_state_str, (p_game_data_obj->detailed_state.len + 1), p_game_data_obj->detailed_state.str, p_game_data_obj->detailed_state.len);
-                strncpy_s(img_url_str, (p_game_data_obj->img_url.len + 1), p_game_data_obj->img_url.str, p_game_data_obj->img_url.len);
-
-                // Convert the scores to strings
-                snprintf(p_node->p_data->home_team_score_str, MAX_UINT32_STR_LEN, "%d", p_game_data_obj->home_score);
-                snprintf(p_node->p_data->away_team_score_str, MAX_UINT32_STR_LEN, "%d", p_game_data_obj->away_score);
-
-                // Last thing to do is download the image data
-                memset(p_img_buff, 0, sizeof(httpDataBuffer_t));
-                if (curlLibGetData(p_img_buff, img_url_str) == APPERR_OK)
-                {
-                    p_node->p_data->p_img_data = p_img_buff;
-                }
-            }
-            else
+            jsonStringCacheReset(&p_parser->worker_strings[idx]);
+        }
+
+        gameDataParallelGames_t parallel_games =
             {
-                // TODO: Malloc failed,  Free all previously malloc'd items
+                .p_tok_data = p_tok_data,
+                .p_json_buff = p_json_buff,
+                .p_game_toks = &game_toks,
+                .p_games = p_games,
+                .p_found_keys = p_found_keys,
+                .p_worker_strings = p_parser->worker_strings,
+            };
+        const int num_jobs = ((game_toks.num_games + GAME_DATA_PARALLEL_CHUNK_SIZE - 1) / GAME_DATA_PARALLEL_CHUNK_SIZE);
+        workerPoolRun(&p_parser->workers, gameDataDeserializeChunkJob, &parallel_games, num_jobs);
+        num_deserialized = game_toks.num_games;
+    }
+    else
+    {
+        // Nowhere to keep track of the games, do it one array at a time instead
+        num_deserialized = gameDataDeserializeGames(p_tok_data, p_json_buff, p_games, p_found_keys, max_games);
+    }
 
-                p_node = NULL;
-            }
+    free(game_toks.p_toks);
+    return num_deserialized;
+}
+
+// Path expression match callback, called for each game object
+static bool gameDataGameTokCbk(void *p_ctx, const jsmnTokenizationData_t *const p_tok_data, const int tok_idx)
+{
+    gameDataGameToks_t *const p_game_toks = (gameDataGameToks_t *)p_ctx;
+
+    if (p_game_toks->num_games < p_game_toks->max_games)
+    {
+        p_game_toks->p_toks[p_game_toks->num_games++] = tok_idx;
+    }
+
+    return (p_game_toks->num_games < p_game_toks->max_games);
+}
+
+// Worker pool job, deserializes one chunk of games. The tokens are shared by all of the workers, but each worker
+// decodes strings into its own cache.
+static void gameDataDeserializeChunkJob(void *p_ctx, const int job_idx, const int worker_idx)
+{
+    const gameDataParallelGames_t *const p_parallel_games = (const gameDataParallelGames_t *)p_ctx;
+    const gameDataGameToks_t *const p_game_toks = p_parallel_games->p_game_toks;
+
+    jsmnTokenizationData_t tok_data = *p_parallel_games->p_tok_data;
+    tok_data.p_string_cache = &p_parallel_games->p_worker_strings[worker_idx];
+
+    const int first_game = (job_idx * GAME_DATA_PARALLEL_CHUNK_SIZE);
+    const int end_game = min((first_game + GAME_DATA_PARALLEL_CHUNK_SIZE), p_game_toks->num_games);
+    for (int idx = first_game; idx < end_game; idx++)
+    {
+        jsonDeserializeObject(&g_game_obj_schema, &tok_data, p_parallel_games->p_json_buff, p_game_toks->p_toks[idx],
+                              &p_parallel_games->p_games[idx], &p_parallel_games->p_found_keys[idx * GAME_DATA_OBJ_NUM_KEYS]);
+    }
+}
+
+// Deserializes a single game object. The game object must be the root of the token data.
+// Returns APPERR_JSON_MISSING_REQUIRED_KEY if the game is missing any of the keys it can't do without.
+static appErrors_t gameDataDeserializeGameObj(const jsmnTokenizationData_t *const p_game_tok_data, const char *const p_obj_buff,
+                                              gameDataObj_t *const p_game_obj)
+{
+    bool found_keys[GAME_DATA_OBJ_NUM_KEYS] = {false};
+
+    memset(p_game_obj, 0, sizeof(gameDataObj_t));
+#if (GAME_DATA_GENERATED_DESERIALIZER_ENABLED == 1)
+    int num_found = 0;
+    gameDataObjDeserialize(p_game_tok_data->p_tokens, p_game_tok_data->num_tokens, 0, p_obj_buff,
+                           p_game_tok_data->p_string_cache, p_game_obj, found_keys, &num_found);
+#else
+    jsonPathTrieDeserialize(&g_game_obj_trie, p_game_tok_data, p_obj_buff, p_game_obj, found_keys);
+#endif
+
+    return gameDataCheckGameKeys(found_keys);
+}
+
+// Checks that a game has every key that is not optional, reporting the first one that is missing
+static appErrors_t gameDataCheckGameKeys(const bool *const p_found_keys)
+{
+    appErrors_t status = APPERR_OK;
+
+    jsonMissingKeys_t missing;
+    if (!jsonCheckRequiredKeys(g_list_of_game_obj_values, GAME_DATA_OBJ_NUM_KEYS, p_found_keys, &missing))
+    {
+        printf("Game skipped, \"%s\" is missing (%d required key(s) missing)\n",
+               g_list_of_game_obj_values[missing.first_missing_idx].key_str, missing.num_missing_required);
+        status = APPERR_JSON_MISSING_REQUIRED_KEY;
+    }
+
+    return status;
+}
+
+// Builds a game of the list out of its deserialized game object
+// Everything the game points to is allocated out of `p_arena`, which belongs to `p_dataset` (or is added to it later).
+// Team names and the game state are interned in `p_strings`, which can be shared with other threads.
+// Returns false if the game could not be allocated.
+static bool gameDataDeserializeGame(const gameDataObj_t *p_game_data_obj, gameData_t *const p_data,
+                                    gameDataSet_t *const p_dataset, memArena_t *const p_arena,
+                                    stringInternTable_t *const p_strings)
+{
+    // Clear out the dataspace to ensure no garbage in the pointers
+    memset(p_data, 0, sizeof(gameData_t));
+    p_data->p_dataset = p_dataset;
+
+    // Set the variables in the game data that do not need to be allocated
+    strncpy_s(p_data->date_str, ARRAY_SIZE(p_data->date_str), p_game_data_obj->game_date.str, p_game_data_obj->game_date.len);
+
+    p_data->home_team_name_str = gameDataInternString(p_strings, p_dataset, p_arena, &p_game_data_obj->home_team_name);
+    p_data->away_team_name_str = gameDataInternString(p_strings, p_dataset, p_arena, &p_game_data_obj->away_team_name);
+    p_data->detailed_state_str = gameDataInternString(p_strings, p_dataset, p_arena, &p_game_data_obj->detailed_state);
+
+    p_data->home_team_score = p_game_data_obj->home_score;
+    p_data->away_team_score = p_game_data_obj->away_score;
+
+    // Img URL is going to be used to download the image. Games without a recap (i.e. postponed games) have none,
+    // they are kept without an image.
+    const bool has_img = (p_game_data_obj->img_url.len > 0);
+    gameDataStr_t img_url = {.str = NULL, .len = 0, .intern_id = GAME_DATA_STR_NOT_INTERNED};
+    if (has_img)
+    {
+        img_url = gameDataSetString(p_dataset, p_arena, &p_game_data_obj->img_url);
+    }
+
+    // Whatever was allocated for a game that can't be completed is freed with the arena
+    const bool success = (p_data->home_team_name_str.str != NULL &&
+                          p_data->away_team_name_str.str != NULL &&
+                          p_data->detailed_state_str.str != NULL &&
+                          (!has_img || (img_url.str != NULL)));
+    if (success && has_img)
+    {
+        // Last thing to do is download the image data
+        p_data->p_img_data = gameDataDownloadImage(p_arena, img_url.str);
+    }
+
+    return success;
+}
+
+// Downloads an image and copies it into the arena, so the download buffer goes straight back to the pool.
+// Returns NULL if the image could not be downloaded.
+static httpDataBuffer_t *gameDataDownloadImage(memArena_t *const p_arena, const char *const p_img_url)
+{
+    httpDataBuffer_t download_buff;
+    curlLibBufferInit(&download_buff);
+
+    // A failed transfer can still report success, with nothing received
+    httpDataBuffer_t *p_img_data = NULL;
+    if ((curlLibGetData(&download_buff, p_img_url) == APPERR_OK) &&
+        (download_buff.p_buffer != NULL) && (download_buff.content_length > 0))
+    {
+        p_img_data = memArenaAlloc(p_arena, sizeof(httpDataBuffer_t));
+        char *p_img_buff = memArenaAlloc(p_arena, download_buff.content_length);
+        if ((p_img_data != NULL) && (p_img_buff != NULL))
+        {
+            memcpy(p_img_buff, download_buff.p_buffer, download_buff.content_length);
+            p_img_data->p_buffer = p_img_buff;
+            p_img_data->p_pos = (p_img_buff + download_buff.content_length);
+            p_img_data->size = download_buff.content_length;
+            p_img_data->content_length = download_buff.content_length;
+            p_img_data->buffer_id = JSON_BUFFER_ID_NONE; // Not from the pool, never freed on its own
         }
         else
         {
-            // TODO: Malloc failed,  Free all previously malloc'd items
+            p_img_data = NULL;
+        }
+    }
+    curlLibFreeData(&download_buff);
+
+    return p_img_data;
+}
+
+// Starts the dataset of a gather, at the start of its own arena. `expected_size` is the memory the games are expected
+// to need, or 0 if unknown. The dataset starts with one reference, which the list of games takes over.
+static gameDataSet_t *gameDataSetCreate(const size_t expected_size)
+{
+    memArena_t arena;
+    memArenaInit(&arena, (expected_size > 0) ? min((sizeof(gameDataSet_t) + expected_size), MEM_ARENA_MAX_BLOCK_SIZE) : 0);
+
+    gameDataSet_t *p_dataset = memArenaAlloc(&arena, sizeof(gameDataSet_t));
+    if (p_dataset != NULL)
+    {
+        SDL_AtomicSet(&p_dataset->ref_count, 1);
+        curlLibBufferInit(&p_dataset->json_data);
+        p_dataset->arena = arena;
+    }
+
+    return p_dataset;
+}
+
+// Takes the download buffer over from `p_json_data`, for the strings of the games to point into
+static void gameDataSetKeepJson(gameDataSet_t *const p_dataset, httpDataBuffer_t *const p_json_data)
+{
+    p_dataset->json_data = *p_json_data;
+    curlLibBufferInit(p_json_data);
+}
+
+// Hands the dataset over to the list of games built out of it and indexes the games, or frees it if there are no games
+static void gameDataSetFinish(gameDataParser_t *const p_parser, gameDataSet_t *const p_dataset,
+                              gameDataList_t *const p_list)
+{
+    p_parser->num_list_blocks += p_dataset->arena.num_blocks;
+
+    if (p_list->num_games > 0)
+    {
+        p_list->p_dataset = p_dataset;
+
+#if (GAME_DATA_INDEXING_ENABLED == 1)
+        // The games are where they will stay, index them by position
+        bool indexed = true;
+        for (int idx = 0; idx < p_list->num_games; idx++)
+        {
+            indexed = gameDataIndexAdd(&p_list->index, &p_list->p_games[idx], idx) && indexed;
+        }
+        indexed = gameDataIndexUpdate(&p_list->index) && indexed;
 
-            p_node = NULL;
+        if (!indexed)
+        {
+            // Partial indexes would miss games, queries find nothing instead
+            printf("Failed to index the games\n");
+            gameDataIndexDestroy(&p_list->index);
         }
+#endif
+    }
+    else
+    {
+        gameDataSetRelease(p_dataset);
+        p_list->p_games = NULL;
+    }
+}
+
+// Drops a reference to the dataset, the last one frees it along with every game in it
+static void gameDataSetRelease(gameDataSet_t *const p_dataset)
+{
+    if (SDL_AtomicDecRef(&p_dataset->ref_count))
+    {
+        curlLibFreeData(&p_dataset->json_data);
+
+        // The dataset is in its own arena
+        memArena_t arena = p_dataset->arena;
+        memArenaDestroy(&arena);
+    }
+}
+
+// Checks whether a string points into the downloaded JSON data, as opposed to the string cache
+static bool gameDataInJsonData(const httpDataBuffer_t *const p_json_data, const jsonStr_t *const p_src)
+{
+    const uintptr_t data_start = (uintptr_t)p_json_data->p_buffer;
+    const uintptr_t str_start = (uintptr_t)p_src->str;
+
+    return ((p_src->str != NULL) && (str_start >= data_start) &&
+            ((str_start - data_start) < p_json_data->content_length));
+}
+
+// Gets a string of a game. Strings in the JSON data the dataset kept are used where they are, and NULL terminated
+// over their closing quote. Anything else is copied into the arena. The string is NULL if it could not be allocated.
+static gameDataStr_t gameDataSetString(gameDataSet_t *const p_dataset, memArena_t *const p_arena,
+                                       const jsonStr_t *const p_src)
+{
+    char *p_str = NULL;
+    if (gameDataInJsonData(&p_dataset->json_data, p_src))
+    {
+        p_str = &p_dataset->json_data.p_buffer[(uintptr_t)p_src->str - (uintptr_t)p_dataset->json_data.p_buffer];
+        assert(p_str[p_src->len] == '"');
+        p_str[p_src->len] = '\0';
+    }
+    else
+    {
+        p_str = memArenaStrDup(p_arena, p_src->str, p_src->len);
+    }
+
+    gameDataStr_t view = {.str = p_str, .len = p_src->len, .intern_id = GAME_DATA_STR_NOT_INTERNED};
+    return view;
+}
+
+// Gets a string of a game that is likely to be repeated across games, out of the string table. Falls back on the
+// dataset's string if interning is disabled, or the string could not be added to the table.
+static gameDataStr_t gameDataInternString(stringInternTable_t *const p_strings, gameDataSet_t *const p_dataset,
+                                          memArena_t *const p_arena, const jsonStr_t *const p_src)
+{
+    gameDataStr_t text = {.str = NULL, .len = p_src->len, .intern_id = GAME_DATA_STR_NOT_INTERNED};
+
+#if (GAME_DATA_STRING_INTERNING_ENABLED == 1)
+    text.intern_id = stringInternAdd(p_strings, p_src->str, p_src->len, &text.str);
+#endif
+
+    if (text.intern_id == GAME_DATA_STR_NOT_INTERNED)
+    {
+        text = gameDataSetString(p_dataset, p_arena, p_src);
     }
 
-    return p_node;
+    return text;
 }
@@ -37,24 +37,68 @@
 /* ***************************    Includes     **************************** */
 
 #include "shared_data_types.h"
+#include "json_deserialization.h"
+#include "json_string.h"
+#include "string_intern.h"
+#include "game_data_index.h"
+#include "worker_pool.h"
 
 /* ***************************   Definitions   **************************** */
 
+// Number of threads of the parser's worker pool, used by parallel parsing and deserialization,
+// including the calling thread
+#define GAME_DATA_NUM_PARSE_THREADS                 4
+
 /* ****************************   Structures   **************************** */
 
-typedef struct gameDataNode gameDataNode_t;
+// Games gathered from a JSON document, in document order. The games are stored one after the other, so they can be
+// indexed, sorted or searched in place. They belong to the dataset of the gather, with everything they point to.
+typedef struct
+{
+    gameData_t *p_games;
+    int num_games;
+    struct GameDataSet *p_dataset; // NULL when there are no games
+
+    // Positions of the games by team, state and day, see gameDataIndexFind()
+    gameDataIndex_t index;
+} gameDataList_t;
+
+// State the parser keeps from one gather to the next, so refreshing the game data reuses its memory
+typedef struct
+{
+    jsonTokenArena_t document_tokens;                           // Tokens of the whole JSON document
+    jsonTokenArena_t game_tokens[GAME_DATA_NUM_PARSE_THREADS];  // Tokens of a single game, one arena per parse thread
+
+    // Threads the games are shared out to, started by the first gather that needs them
+    // NOTE: The pool can't be moved once started, neither can the parser
+    workerPool_t workers;
+    bool workers_started;
+    jsonStringCache_t worker_strings[GAME_DATA_NUM_PARSE_THREADS]; // Strings decoded by each worker
+
+    int num_list_blocks; // Memory blocks the lists of games were built in, over all gathers
+
+    // Team names and game states of every gather, see GAME_DATA_STRING_INTERNING_ENABLED
+    stringInternTable_t strings;
+} gameDataParser_t;
 
-// Linked list node
-struct gameDataNode
+// Token usage of a parser, summed over all of its gathers
+typedef struct
 {
-    gameDataNode_t *next;
-    gameDataNode_t *prev;
-    gameData_t *p_data;
-};
+    int peak_document_tokens;    // Most tokens needed for a whole JSON document
+    int peak_game_tokens;        // Most tokens needed for a single game
+    int num_token_reallocations; // Times token storage had to be (re)allocated
+    int num_tokenizations;
+    int num_list_allocations;    // Allocations made for the lists of games (blocks of their arenas)
+    int num_interned_strings;    // Distinct team names and game states
+    int num_intern_lookups;      // Team names and game states looked up, one per string of each game
+} gameDataParserStats_t;
 
 /* ***********************   Function Prototypes   ************************ */
 
-gameDataNode_t *gameDataParserGatherData(const char *const p_json_url);
-void gameDataParserGameListDestroy(gameDataNode_t *p_list);
+void gameDataParserInit(gameDataParser_t *const p_parser);
+void gameDataParserDestroy(gameDataParser_t *const p_parser);
+void gameDataParserGetStats(const gameDataParser_t *const p_parser, gameDataParserStats_t *const p_stats);
+bool gameDataParserGatherData(gameDataParser_t *const p_parser, const char *const p_json_url, gameDataList_t *const p_list);
+void gameDataParserGameListDestroy(gameDataList_t *const p_list);
 
 #endif /* GAME_DATA_PARSER_H */
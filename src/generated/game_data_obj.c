@@ -0,0 +1,902 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  game_data_obj.c
+//
+//  GENERATED by tools/json_codegen.py from game_data_obj.schema, DO NOT EDIT
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/* ***************************    Includes     **************************** */
+
+// Standard Includes
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Project Includes
+#include "utility.h"
+#include "json_number.h"
+#include "json_string.h"
+
+// Module Includes
+#include "game_data_obj.h"
+
+/* ***************************   Definitions   **************************** */
+
+// Marks a key of the table as found
+#define JSON_GEN_FOUND(key_idx)                 \
+    do                                          \
+    {                                           \
+        if (p_found_keys != NULL)               \
+        {                                       \
+            p_found_keys[(key_idx)] = true;     \
+        }                                       \
+        (*p_num_found)++;                       \
+    } while (0)
+
+/* ***********************   Function Prototypes   ************************ */
+
+static int gameDataObjDeserializeObject(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeTeams(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeTeamsHome(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeTeamsHomeTeam(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeTeamsAway(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeTeamsAwayTeam(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeStatus(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeContent(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeContentEditorial(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeContentEditorialRecap(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeContentEditorialRecapHome(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeContentEditorialRecapHomePhoto(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeContentEditorialRecapHomePhotoCuts(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int gameDataObjDeserializeContentEditorialRecapHomePhotoCuts480x270(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found);
+static int jsonGenSkipValue(const jsmntok_t *const p_tokens, const int num_tokens, const int tok_idx);
+
+/* ***********************   File Scope Variables   *********************** */
+
+const jsonKeyValue_t g_list_of_game_obj_values[GAME_DATA_OBJ_NUM_KEYS] =
+    {
+        {.key_str = "gameDate",
+         .c_type = E_JSON_C_STR_PTR,
+         .value_tok_type = JSMN_STRING,
+         .struct_member_offset = offsetof(gameDataObj_t, game_date),
+         .struct_member_size = MEMBER_SIZE(gameDataObj_t, game_date)},
+        {.key_str = "teams.home.team.name",
+         .c_type = E_JSON_C_STR_PTR,
+         .value_tok_type = JSMN_STRING,
+         .struct_member_offset = offsetof(gameDataObj_t, home_team_name),
+         .struct_member_size = MEMBER_SIZE(gameDataObj_t, home_team_name)},
+        {.key_str = "teams.away.team.name",
+         .c_type = E_JSON_C_STR_PTR,
+         .value_tok_type = JSMN_STRING,
+         .struct_member_offset = offsetof(gameDataObj_t, away_team_name),
+         .struct_member_size = MEMBER_SIZE(gameDataObj_t, away_team_name)},
+        {.key_str = "teams.home.score",
+         .c_type = E_JSON_C_UINT32,
+         .value_tok_type = JSMN_PRIMITIVE,
+         .struct_member_offset = offsetof(gameDataObj_t, home_score),
+         .struct_member_size = MEMBER_SIZE(gameDataObj_t, home_score)},
+        {.key_str = "teams.away.score",
+         .c_type = E_JSON_C_UINT32,
+         .value_tok_type = JSMN_PRIMITIVE,
+         .struct_member_offset = offsetof(gameDataObj_t, away_score),
+         .struct_member_size = MEMBER_SIZE(gameDataObj_t, away_score)},
+        {.key_str = "status.detailedState",
+         .c_type = E_JSON_C_STR_PTR,
+         .value_tok_type = JSMN_STRING,
+         .struct_member_offset = offsetof(gameDataObj_t, detailed_state),
+         .struct_member_size = MEMBER_SIZE(gameDataObj_t, detailed_state)},
+        {.key_str = "content.editorial.recap.home.photo.cuts.480x270.src",
+         .c_type = E_JSON_C_STR_PTR,
+         .value_tok_type = JSMN_STRING,
+         .optional = true,
+         .struct_member_offset = offsetof(gameDataObj_t, img_url),
+         .struct_member_size = MEMBER_SIZE(gameDataObj_t, img_url)},
+};
+
+/* ****************************   BEGIN CODE   **************************** */
+
+/* *************************   Public  Functions   ************************ */
+
+// Deserializes the object at obj_tok_idx into the gameDataObj_t at p_data, walking its tokens once and
+// stopping as soon as every key has been found.
+// p_string_cache[in]: Cache of the token arena p_tokens come from, decodes the escaped strings.
+// p_found_keys[out]: Optional, can be NULL. Set to true for every entry of g_list_of_game_obj_values deserialized.
+// p_num_found[in/out]: Incremented for every key deserialized
+// Returns the index of the token following the object (and everything inside of it).
+int gameDataObjDeserialize(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, void *const p_data,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    int next_tok_idx = (obj_tok_idx + 1);
+    if (p_tokens[obj_tok_idx].type == JSMN_OBJECT)
+    {
+        next_tok_idx = gameDataObjDeserializeObject(p_tokens, num_tokens, obj_tok_idx, p_json_buff, p_string_cache,
+            (gameDataObj_t *)p_data, p_found_keys, p_num_found);
+    }
+
+    return next_tok_idx;
+}
+
+/* *************************   Private Functions   ************************ */
+
+// Keys of "(root)"
+static int gameDataObjDeserializeObject(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0x140C8EEDu: // "teams"
+                if ((key_len == 5) && (memcmp(&p_json_buff[p_key->start], "teams", 5) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeTeams(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            case 0x81DC8043u: // "gameDate"
+                if ((key_len == 8) && (memcmp(&p_json_buff[p_key->start], "gameDate", 8) == 0) &&
+                    (p_value->type == JSMN_STRING))
+                {
+                    p_obj->game_date = jsonStringCacheGet(p_string_cache, p_json_buff, p_value);
+                    JSON_GEN_FOUND(0);
+                }
+                break;
+
+            case 0x90BEC3C2u: // "content"
+                if ((key_len == 7) && (memcmp(&p_json_buff[p_key->start], "content", 7) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeContent(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            case 0xBA4B77EFu: // "status"
+                if ((key_len == 6) && (memcmp(&p_json_buff[p_key->start], "status", 6) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeStatus(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 7);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "teams"
+static int gameDataObjDeserializeTeams(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0x54EA875Bu: // "away"
+                if ((key_len == 4) && (memcmp(&p_json_buff[p_key->start], "away", 4) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeTeamsAway(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            case 0xD2C8C28Eu: // "home"
+                if ((key_len == 4) && (memcmp(&p_json_buff[p_key->start], "home", 4) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeTeamsHome(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 4);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "teams.home"
+static int gameDataObjDeserializeTeamsHome(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0xA2FD7D0Cu: // "team"
+                if ((key_len == 4) && (memcmp(&p_json_buff[p_key->start], "team", 4) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeTeamsHomeTeam(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            case 0xD22F9095u: // "score"
+                if ((key_len == 5) && (memcmp(&p_json_buff[p_key->start], "score", 5) == 0) &&
+                    (p_value->type == JSMN_PRIMITIVE))
+                {
+                    uint64_t value = 0;
+                    jsonNumberParseUint(&p_json_buff[p_value->start], (p_value->end - p_value->start), UINT32_MAX, &value);
+                    p_obj->home_score = (uint32_t)value;
+                    JSON_GEN_FOUND(3);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 2);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "teams.home.team"
+static int gameDataObjDeserializeTeamsHomeTeam(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0x8D39BDE6u: // "name"
+                if ((key_len == 4) && (memcmp(&p_json_buff[p_key->start], "name", 4) == 0) &&
+                    (p_value->type == JSMN_STRING))
+                {
+                    p_obj->home_team_name = jsonStringCacheGet(p_string_cache, p_json_buff, p_value);
+                    JSON_GEN_FOUND(1);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 1);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "teams.away"
+static int gameDataObjDeserializeTeamsAway(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0xA2FD7D0Cu: // "team"
+                if ((key_len == 4) && (memcmp(&p_json_buff[p_key->start], "team", 4) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeTeamsAwayTeam(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            case 0xD22F9095u: // "score"
+                if ((key_len == 5) && (memcmp(&p_json_buff[p_key->start], "score", 5) == 0) &&
+                    (p_value->type == JSMN_PRIMITIVE))
+                {
+                    uint64_t value = 0;
+                    jsonNumberParseUint(&p_json_buff[p_value->start], (p_value->end - p_value->start), UINT32_MAX, &value);
+                    p_obj->away_score = (uint32_t)value;
+                    JSON_GEN_FOUND(4);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 2);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "teams.away.team"
+static int gameDataObjDeserializeTeamsAwayTeam(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0x8D39BDE6u: // "name"
+                if ((key_len == 4) && (memcmp(&p_json_buff[p_key->start], "name", 4) == 0) &&
+                    (p_value->type == JSMN_STRING))
+                {
+                    p_obj->away_team_name = jsonStringCacheGet(p_string_cache, p_json_buff, p_value);
+                    JSON_GEN_FOUND(2);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 1);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "status"
+static int gameDataObjDeserializeStatus(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0x2BE587D6u: // "detailedState"
+                if ((key_len == 13) && (memcmp(&p_json_buff[p_key->start], "detailedState", 13) == 0) &&
+                    (p_value->type == JSMN_STRING))
+                {
+                    p_obj->detailed_state = jsonStringCacheGet(p_string_cache, p_json_buff, p_value);
+                    JSON_GEN_FOUND(5);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 1);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "content"
+static int gameDataObjDeserializeContent(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0xE0DBD3DEu: // "editorial"
+                if ((key_len == 9) && (memcmp(&p_json_buff[p_key->start], "editorial", 9) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeContentEditorial(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 1);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "content.editorial"
+static int gameDataObjDeserializeContentEditorial(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0x3E308718u: // "recap"
+                if ((key_len == 5) && (memcmp(&p_json_buff[p_key->start], "recap", 5) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeContentEditorialRecap(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 1);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "content.editorial.recap"
+static int gameDataObjDeserializeContentEditorialRecap(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0xD2C8C28Eu: // "home"
+                if ((key_len == 4) && (memcmp(&p_json_buff[p_key->start], "home", 4) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeContentEditorialRecapHome(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 1);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "content.editorial.recap.home"
+static int gameDataObjDeserializeContentEditorialRecapHome(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0x812716E3u: // "photo"
+                if ((key_len == 5) && (memcmp(&p_json_buff[p_key->start], "photo", 5) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeContentEditorialRecapHomePhoto(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 1);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "content.editorial.recap.home.photo"
+static int gameDataObjDeserializeContentEditorialRecapHomePhoto(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0x79A9EC10u: // "cuts"
+                if ((key_len == 4) && (memcmp(&p_json_buff[p_key->start], "cuts", 4) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeContentEditorialRecapHomePhotoCuts(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 1);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "content.editorial.recap.home.photo.cuts"
+static int gameDataObjDeserializeContentEditorialRecapHomePhotoCuts(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0x4CA4E4DEu: // "480x270"
+                if ((key_len == 7) && (memcmp(&p_json_buff[p_key->start], "480x270", 7) == 0) &&
+                    (p_value->type == JSMN_OBJECT))
+                {
+                    next_tok_idx = gameDataObjDeserializeContentEditorialRecapHomePhotoCuts480x270(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,
+                        p_obj, p_found_keys, p_num_found);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 1);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Keys of "content.editorial.recap.home.photo.cuts.480x270"
+static int gameDataObjDeserializeContentEditorialRecapHomePhotoCuts480x270(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, gameDataObj_t *const p_obj,
+    bool *const p_found_keys, int *const p_num_found)
+{
+    const int num_keys = p_tokens[obj_tok_idx].size;
+    const int num_found_before = *p_num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)
+    {
+        const jsmntok_t *const p_key = &p_tokens[tok_idx];
+        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];
+        const int key_len = (p_key->end - p_key->start);
+        int next_tok_idx = -1;
+
+        switch (p_key->hash)
+        {
+            case 0xD33CE1C9u: // "src"
+                if ((key_len == 3) && (memcmp(&p_json_buff[p_key->start], "src", 3) == 0) &&
+                    (p_value->type == JSMN_STRING))
+                {
+                    p_obj->img_url = jsonStringCacheGet(p_string_cache, p_json_buff, p_value);
+                    JSON_GEN_FOUND(6);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        // Values that were not walked into are stepped over
+        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));
+        all_found = ((*p_num_found - num_found_before) >= 1);
+    }
+
+    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Gets the index of the token following a value and everything inside of it
+static int jsonGenSkipValue(const jsmntok_t *const p_tokens, const int num_tokens, const int tok_idx)
+{
+    const int value_end = p_tokens[tok_idx].end;
+    int next_tok_idx = (tok_idx + 1);
+
+    if ((next_tok_idx < num_tokens) && (p_tokens[next_tok_idx].start < value_end))
+    {
+        // Tokens are in the order they start at, the first one past the value is found with a binary search.
+        // Every token takes up at least a byte, so there are no more tokens in the value than it has bytes.
+        const int max_tok_idx = (next_tok_idx + (value_end - p_tokens[tok_idx].start));
+        int high_idx = (max_tok_idx < num_tokens) ? max_tok_idx : num_tokens;
+        while (next_tok_idx < high_idx)
+        {
+            const int mid_idx = next_tok_idx + ((high_idx - next_tok_idx) / 2);
+            if (p_tokens[mid_idx].start < value_end)
+            {
+                next_tok_idx = (mid_idx + 1);
+            }
+            else
+            {
+                high_idx = mid_idx;
+            }
+        }
+    }
+
+    return next_tok_idx;
+}
@@ -0,0 +1,70 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  game_data_obj.h
+//
+//  GENERATED by tools/json_codegen.py from game_data_obj.schema, DO NOT EDIT
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef GAME_DATA_OBJ_H
+#define GAME_DATA_OBJ_H
+
+/* ***************************    Includes     **************************** */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "json_deserialization.h"
+
+/* ***************************   Definitions   **************************** */
+
+// Number of entries in g_list_of_game_obj_values
+#define GAME_DATA_OBJ_NUM_KEYS 7
+
+/* ****************************   Structures   **************************** */
+
+typedef struct
+{
+    jsonStr_t game_date;                 // gameDate
+    jsonStr_t home_team_name;            // teams.home.team.name
+    jsonStr_t away_team_name;            // teams.away.team.name
+    uint32_t home_score;                 // teams.home.score
+    uint32_t away_score;                 // teams.away.score
+    jsonStr_t detailed_state;            // status.detailedState
+    jsonStr_t img_url;                   // content.editorial.recap.home.photo.cuts.480x270.src
+} gameDataObj_t;
+
+/* ***********************   Function Prototypes   ************************ */
+
+int gameDataObjDeserialize(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, void *const p_data,
+    bool *const p_found_keys, int *const p_num_found);
+
+/* ***********************   File Scope Variables   *********************** */
+
+// Table for the generic deserializer, describing the same keys as gameDataObjDeserialize()
+extern const jsonKeyValue_t g_list_of_game_obj_values[GAME_DATA_OBJ_NUM_KEYS];
+
+#endif /* GAME_DATA_OBJ_H */
@@ -35,12 +35,17 @@
 
 /* ***************************    Includes     **************************** */
 
+#include <stdint.h>
+
 /* ***************************   Definitions   **************************** */
 
 // Defines the total length needed to store a ISO8601 string
 // the millisecond component may or may not be actively being used
 #define ISO8601_TIME_STR_LEN                    (sizeof("2018-12-31T11:59:59.999Z"))
 
+// Intern id of text that was not interned, same as STRING_INTERN_ID_NONE
+#define GAME_DATA_STR_NOT_INTERNED              (-1)
+
 /* ****************************   Structures   **************************** */
 
 typedef struct
@@ -49,19 +54,37 @@ typedef struct
     size_t content_length;
     char *p_buffer;
     char *p_pos;
+    int buffer_id;  // Pool bookkeeping of p_buffer, see jsonDataBuffer_t
 } httpDataBuffer_t;
 
 
+// Text of a game, NULL terminated. `len` does not count the NULL byte.
+// Interned text is shared by every game with the same text, and so is its id, which can be used to share whatever is
+// built from the text (i.e. its texture).
+typedef struct
+{
+    const char *str;
+    int len;
+    int intern_id; // GAME_DATA_STR_NOT_INTERNED when the text belongs to the game
+} gameDataStr_t;
+
+// Memory of a list of games, see game_data_parser.c
+struct GameDataSet;
+
 // Data coming out of objects in the "games" array data
 typedef struct
 {
     char date_str[ISO8601_TIME_STR_LEN];  // gameDate
-    char *home_team_name_str;       // teams.away.team.name
-    char *away_team_name_str;       // teams.home.team.name
-    char *home_team_score_str;      // teams.away.score
-    char *away_team_score_str;      // teams.home.score
-    char *detailed_state_str;       // status.detailedState
+    gameDataStr_t home_team_name_str;     // teams.away.team.name
+    gameDataStr_t away_team_name_str;     // teams.home.team.name
+    uint32_t home_team_score;             // teams.home.score, turned into text by the display
+    uint32_t away_team_score;             // teams.away.score
+    gameDataStr_t detailed_state_str;     // status.detailedState
     httpDataBuffer_t* p_img_data;   // Pointer to data that contains the image data.
+
+    // Dataset the game was allocated out of, along with its strings and image. The strings may also point
+    // into the JSON document the dataset keeps.
+    struct GameDataSet *p_dataset;
 }gameData_t;
 
 
@@ -14,6 +14,9 @@ static jsmntok_t *jsmn_alloc_token(jsmn_parser *parser,
     tok->size = 0;
 #ifdef JSMN_PARENT_LINKS
     tok->parent = -1;
+#endif
+#ifdef JSMN_KEY_HASH
+    tok->hash = 0;
 #endif
     return tok;
 }
@@ -106,6 +109,12 @@ static int jsmn_parse_string(jsmn_parser *parser, const char *js,
             jsmn_fill_token(token, JSMN_STRING, start+1, parser->pos);
 #ifdef JSMN_PARENT_LINKS
             token->parent = parser->toksuper;
+#endif
+#ifdef JSMN_KEY_HASH
+            /* A string directly inside of an object is a key */
+            if (parser->toksuper != -1 && tokens[parser->toksuper].type == JSMN_OBJECT) {
+                token->hash = jsmn_hash(js + start + 1, parser->pos - start - 1);
+            }
 #endif
             return 0;
         }
@@ -145,6 +154,93 @@ static int jsmn_parse_string(jsmn_parser *parser, const char *js,
     return JSMN_ERROR_PART;
 }
 
+#ifdef JSMN_FILTER
+/**
+ * Skips over a complete JSON value without producing tokens. Objects and arrays
+ * are skipped by bracket matching. Leaves the position on the last character of the value.
+ */
+static int jsmn_skip_value(jsmn_parser *parser, const char *js, size_t len) {
+    unsigned int start = parser->pos;
+    int depth = 0;
+    char c = js[parser->pos];
+
+    if (c == '{' || c == '[') {
+        for (; parser->pos < len && js[parser->pos] != '\0'; parser->pos++) {
+            c = js[parser->pos];
+            if (c == '\"') {
+                /* Brackets inside of strings do not count */
+                for (parser->pos++; parser->pos < len && js[parser->pos] != '\"'; parser->pos++) {
+                    if (js[parser->pos] == '\\') {
+                        parser->pos++;
+                    }
+                }
+                if (parser->pos >= len) {
+                    break;
+                }
+            } else if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    return 0;
+                }
+            }
+        }
+    } else if (c == '\"') {
+        for (parser->pos++; parser->pos < len && js[parser->pos] != '\0'; parser->pos++) {
+            if (js[parser->pos] == '\\') {
+                parser->pos++;
+            } else if (js[parser->pos] == '\"') {
+                return 0;
+            }
+        }
+    } else {
+        for (; parser->pos < len && js[parser->pos] != '\0'; parser->pos++) {
+            switch (js[parser->pos]) {
+                case ':': case '\t' : case '\r' : case '\n' : case ' ' :
+                case ','  : case ']'  : case '}' :
+                    parser->pos--;
+                    return 0;
+            }
+        }
+        /* Primitive runs to the end of the data */
+        parser->pos--;
+        return 0;
+    }
+    parser->pos = start;
+    return JSMN_ERROR_PART;
+}
+
+/**
+ * Asks the filter if the value about to be parsed should be kept. If not, the value
+ * is skipped and the token of its key is released.
+ * Returns 1 if the value was skipped, 0 if it should be parsed.
+ */
+static int jsmn_filter_value(jsmn_parser *parser, const char *js, size_t len,
+        jsmntok_t *tokens) {
+    jsmntok_t *key;
+    int r;
+
+    /* Only values that belong to a key are filtered */
+    if (parser->filter == NULL || tokens == NULL || parser->toksuper == -1 ||
+            tokens[parser->toksuper].type != JSMN_STRING) {
+        return 0;
+    }
+    if (parser->filter(parser->filter_ctx, js, tokens, parser->toksuper)) {
+        return 0;
+    }
+    r = jsmn_skip_value(parser, js, len);
+    if (r < 0) {
+        return r;
+    }
+    /* The key is always the most recently allocated token */
+    key = &tokens[parser->toksuper];
+    tokens[key->parent].size--;
+    parser->toknext--;
+    parser->toksuper = key->parent;
+    return 1;
+}
+#endif
+
 /**
  * Parse JSON string and fill tokens.
  */
@@ -162,6 +258,15 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
         c = js[parser->pos];
         switch (c) {
             case '{': case '[':
+#ifdef JSMN_FILTER
+                r = jsmn_filter_value(parser, js, len, tokens);
+                if (r < 0) return r;
+                if (r > 0) {
+                    /* Key token was released */
+                    count--;
+                    break;
+                }
+#endif
                 count++;
                 if (tokens == NULL) {
                     break;
@@ -229,6 +334,15 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
 #endif
                 break;
             case '\"':
+#ifdef JSMN_FILTER
+                r = jsmn_filter_value(parser, js, len, tokens);
+                if (r < 0) return r;
+                if (r > 0) {
+                    /* Key token was released */
+                    count--;
+                    break;
+                }
+#endif
                 r = jsmn_parse_string(parser, js, len, tokens, num_tokens);
                 if (r < 0) return r;
                 count++;
@@ -274,6 +388,15 @@ int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
 #else
             /* In non-strict mode every unquoted value is a primitive */
             default:
+#endif
+#ifdef JSMN_FILTER
+                r = jsmn_filter_value(parser, js, len, tokens);
+                if (r < 0) return r;
+                if (r > 0) {
+                    /* Key token was released */
+                    count--;
+                    break;
+                }
 #endif
                 r = jsmn_parse_primitive(parser, js, len, tokens, num_tokens);
                 if (r < 0) return r;
@@ -310,5 +433,32 @@ void jsmn_init(jsmn_parser *parser) {
     parser->pos = 0;
     parser->toknext = 0;
     parser->toksuper = -1;
+#ifdef JSMN_FILTER
+    parser->filter = NULL;
+    parser->filter_ctx = NULL;
+#endif
 }
 
+#ifdef JSMN_FILTER
+/**
+ * Attaches a value filter to the parser.
+ */
+void jsmn_set_filter(jsmn_parser *parser, jsmn_filter_fn filter, void *ctx) {
+    parser->filter = filter;
+    parser->filter_ctx = ctx;
+}
+#endif
+
+#ifdef JSMN_KEY_HASH
+/**
+ * Hash a key string of the given length.
+ */
+unsigned int jsmn_hash(const char *str, size_t len) {
+    unsigned int hash = JSMN_HASH_INIT;
+    size_t i;
+    for (i = 0; i < len; i++) {
+        hash = JSMN_HASH_STEP(hash, str[i]);
+    }
+    return hash;
+}
+#endif
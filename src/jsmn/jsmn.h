@@ -28,6 +28,14 @@
 /* Include the parent links so we can more easily traverse the JSON structure. */
 #define JSMN_PARENT_LINKS
 
+/* Allow a filter callback to drop object values (and their whole subtree) while parsing.
+ * Requires the parent links, as the filter uses them to rebuild the key path. */
+#define JSMN_FILTER
+
+/* Hash the key strings of objects while parsing, so keys can be compared as integers first.
+ * Only key tokens are hashed, the hash of every other token is 0. */
+#define JSMN_KEY_HASH
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -71,8 +79,29 @@ typedef struct {
 #ifdef JSMN_PARENT_LINKS
     int parent;
 #endif
+#ifdef JSMN_KEY_HASH
+    unsigned int hash;
+#endif
 } jsmntok_t;
 
+#ifdef JSMN_KEY_HASH
+/**
+ * FNV-1a hash of the raw (still escaped) characters of a key. Exposed so keys
+ * being searched for can be hashed the same way as the key tokens.
+ */
+#define JSMN_HASH_INIT          2166136261u
+#define JSMN_HASH_STEP(h, c)    (((h) ^ (unsigned char)(c)) * 16777619u)
+#endif
+
+#ifdef JSMN_FILTER
+/**
+ * Filter callback. Called with the index of a key token before its value is parsed.
+ * Return non-zero to keep the value, zero to skip it. Skipped values (and their keys)
+ * do not produce any tokens.
+ */
+typedef int (*jsmn_filter_fn)(void *ctx, const char *js, const jsmntok_t *tokens, int key_tok_idx);
+#endif
+
 /**
  * JSON parser. Contains an array of token blocks available. Also stores
  * the string being parsed now and current position in that string
@@ -81,6 +110,10 @@ typedef struct {
     unsigned int pos; /* offset in the JSON string */
     unsigned int toknext; /* next token to allocate */
     int toksuper; /* superior token node, e.g parent object or array */
+#ifdef JSMN_FILTER
+    jsmn_filter_fn filter; /* optional value filter, NULL keeps everything */
+    void *filter_ctx; /* passed back to the filter */
+#endif
 } jsmn_parser;
 
 /**
@@ -95,6 +128,21 @@ void jsmn_init(jsmn_parser *parser);
 int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
         jsmntok_t *tokens, unsigned int num_tokens);
 
+#ifdef JSMN_FILTER
+/**
+ * Attach a value filter to an initialized parser. Filtering only applies when
+ * tokens are being produced (not in the token counting mode).
+ */
+void jsmn_set_filter(jsmn_parser *parser, jsmn_filter_fn filter, void *ctx);
+#endif
+
+#ifdef JSMN_KEY_HASH
+/**
+ * Hash a key string of the given length, matches the hash of the key tokens.
+ */
+unsigned int jsmn_hash(const char *str, size_t len);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,209 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  json_data_buffer.c
+//
+//  JSON Data Buffer
+//
+//  Module allows other modules to allocate and free buffers, primarily for
+//  the sake of buffering JSON data that is downloaded and tokenized.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/* ***************************    Includes     **************************** */
+
+// Standard Includes
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+// Library Includes
+#include <SDL.h>
+
+// Project Includes
+#include "utility.h"
+
+// Module Includes
+#include "json_data_buffer.h"
+
+/* ***************************   Definitions   **************************** */
+
+/* ****************************   Structures   **************************** */
+
+// Free buffers are linked through their first bytes, the pool needs no memory of its own
+typedef struct JsonBufferFreeNode
+{
+    struct JsonBufferFreeNode *p_next;
+} jsonBufferFreeNode_t;
+
+/* ***********************   Function Prototypes   ************************ */
+
+static int jsonBufferSizeClass(const int required_size);
+
+/* ***********************   File Scope Variables   *********************** */
+
+static const jsonDataBuffer_t DEFAULT_BUFF = {.p_buff = NULL, .size = 0, .id = JSON_BUFFER_ID_NONE};
+
+// Buffers can be taken and returned from any thread. The lock is only held to push or pop a free list.
+static SDL_SpinLock g_pool_lock = 0;
+static jsonBufferFreeNode_t *g_free_lists[JSON_BUFFER_NUM_CLASSES];
+static jsonBufferStats_t g_pool_stats;
+
+/* ****************************   BEGIN CODE   **************************** */
+
+/* *************************   Public  Functions   ************************ */
+
+//
+// Initialize this module
+// The pool starts out empty, it only fills up as buffers are returned to it
+//
+void jsonBufferInit(void)
+{
+    jsonBufferRelease();
+
+    SDL_AtomicLock(&g_pool_lock);
+    memset(&g_pool_stats, 0, sizeof(g_pool_stats));
+    SDL_AtomicUnlock(&g_pool_lock);
+}
+
+// Frees every buffer held by the pool. Buffers that are out are not affected, and can still be returned.
+void jsonBufferRelease(void)
+{
+    SDL_AtomicLock(&g_pool_lock);
+    jsonBufferFreeNode_t *free_lists[JSON_BUFFER_NUM_CLASSES];
+    memcpy(free_lists, g_free_lists, sizeof(free_lists));
+    memset(g_free_lists, 0, sizeof(g_free_lists));
+    g_pool_stats.pooled_bytes = 0;
+    SDL_AtomicUnlock(&g_pool_lock);
+
+    for (int class_idx = 0; class_idx < JSON_BUFFER_NUM_CLASSES; class_idx++)
+    {
+        jsonBufferFreeNode_t *p_node = free_lists[class_idx];
+        while (p_node != NULL)
+        {
+            jsonBufferFreeNode_t *const p_next = p_node->p_next;
+            free(p_node);
+            p_node = p_next;
+        }
+    }
+}
+
+// Takes a buffer of at least required_size bytes from the pool, or allocates one if the pool has none.
+// The buffer's `size` is set to the size of its class, which can be larger than required.
+// p_buffer[out]: Left as DEFAULT_BUFF if no buffer could be allocated
+// Returns false if no buffer could be allocated.
+bool jsonBufferGetBuffer(jsonDataBuffer_t *const p_buffer, const int required_size)
+{
+    assert(required_size >= 0);
+    *p_buffer = DEFAULT_BUFF;
+
+    const int class_idx = jsonBufferSizeClass(required_size);
+    const int buffer_size = (class_idx != -1) ? (1 << (class_idx + JSON_BUFFER_MIN_CLASS_SHIFT)) : required_size;
+
+    jsonBufferFreeNode_t *p_node = NULL;
+    SDL_AtomicLock(&g_pool_lock);
+    g_pool_stats.num_gets++;
+    if ((class_idx != -1) && (g_free_lists[class_idx] != NULL))
+    {
+        p_node = g_free_lists[class_idx];
+        g_free_lists[class_idx] = p_node->p_next;
+        g_pool_stats.pooled_bytes -= (size_t)buffer_size;
+        g_pool_stats.num_reuses++;
+    }
+    else
+    {
+        g_pool_stats.num_allocations++;
+    }
+    SDL_AtomicUnlock(&g_pool_lock);
+
+    char *const p_buff = (p_node != NULL) ? (char *)p_node : malloc((size_t)buffer_size);
+    if (p_buff != NULL)
+    {
+        p_buffer->p_buff = p_buff;
+        p_buffer->size = buffer_size;
+        p_buffer->id = (class_idx != -1) ? (class_idx + 1) : JSON_BUFFER_ID_UNPOOLED;
+    }
+
+    return (p_buff != NULL);
+}
+
+// Returns a buffer to the pool, and resets it to DEFAULT_BUFF. Buffers that would take the pool over
+// JSON_BUFFER_POOL_MAX_BYTES, or that are too large for any class, are freed instead.
+// NOTE: Returning a DEFAULT_BUFF buffer does nothing, so buffers can be returned whether they were taken or not
+void jsonBufferReturnBuffer(jsonDataBuffer_t *const p_buff)
+{
+    if (p_buff->p_buff != NULL)
+    {
+        assert((p_buff->id == JSON_BUFFER_ID_UNPOOLED) || ((p_buff->id > 0) && (p_buff->id <= JSON_BUFFER_NUM_CLASSES)));
+        bool pooled = false;
+
+        SDL_AtomicLock(&g_pool_lock);
+        if ((p_buff->id > 0) && ((g_pool_stats.pooled_bytes + (size_t)p_buff->size) <= JSON_BUFFER_POOL_MAX_BYTES))
+        {
+            jsonBufferFreeNode_t *const p_node = (jsonBufferFreeNode_t *)p_buff->p_buff;
+            p_node->p_next = g_free_lists[p_buff->id - 1];
+            g_free_lists[p_buff->id - 1] = p_node;
+            g_pool_stats.pooled_bytes += (size_t)p_buff->size;
+            g_pool_stats.peak_pooled_bytes = MAX(g_pool_stats.peak_pooled_bytes, g_pool_stats.pooled_bytes);
+            pooled = true;
+        }
+        else
+        {
+            g_pool_stats.num_frees++;
+        }
+        SDL_AtomicUnlock(&g_pool_lock);
+
+        if (!pooled)
+        {
+            free(p_buff->p_buff);
+        }
+    }
+
+    *p_buff = DEFAULT_BUFF;
+}
+
+// Gets a copy of the pool's counters
+void jsonBufferGetStats(jsonBufferStats_t *const p_stats)
+{
+    SDL_AtomicLock(&g_pool_lock);
+    *p_stats = g_pool_stats;
+    SDL_AtomicUnlock(&g_pool_lock);
+}
+
+/* *************************   Private Functions   ************************ */
+
+// Finds the smallest class that fits required_size bytes
+// Returns the index of the class, or -1 if the size is larger than the largest class
+static int jsonBufferSizeClass(const int required_size)
+{
+    int class_idx = 0;
+    while ((class_idx < JSON_BUFFER_NUM_CLASSES) && ((1 << (class_idx + JSON_BUFFER_MIN_CLASS_SHIFT)) < required_size))
+    {
+        class_idx++;
+    }
+
+    return (class_idx < JSON_BUFFER_NUM_CLASSES) ? class_idx : -1;
+}
@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  json_data_buffer.h
+//
+//  JSON Data Buffer
+//
+//  Pool of data buffers, for the downloaded JSON and image data and the tokens produced from it.
+//  Buffers are handed out in power of 2 size classes, and go back on the free list of their class
+//  when returned, so the next refresh reuses them instead of going back to malloc()/free(). The
+//  memory kept in the pool is capped, buffers returned past the cap are freed.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JSON_DATA_BUFFER_H
+#define JSON_DATA_BUFFER_H
+
+/* ***************************    Includes     **************************** */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ***************************   Definitions   **************************** */
+
+// Size classes, from 2^JSON_BUFFER_MIN_CLASS_SHIFT to 2^JSON_BUFFER_MAX_CLASS_SHIFT bytes.
+// Larger buffers are allocated as requested, and freed when returned.
+#define JSON_BUFFER_MIN_CLASS_SHIFT     10
+#define JSON_BUFFER_MAX_CLASS_SHIFT     26
+#define JSON_BUFFER_NUM_CLASSES         (JSON_BUFFER_MAX_CLASS_SHIFT - JSON_BUFFER_MIN_CLASS_SHIFT + 1)
+
+// Most bytes of free buffers the pool holds on to
+#define JSON_BUFFER_POOL_MAX_BYTES      (32 * 1024 * 1024)
+
+// Buffer ids other than the size classes (which are 1 to JSON_BUFFER_NUM_CLASSES)
+#define JSON_BUFFER_ID_NONE             0   // No buffer
+#define JSON_BUFFER_ID_UNPOOLED         (-1) // Larger than the largest class
+
+/* ****************************   Structures   **************************** */
+
+typedef struct
+{
+    char *p_buff;
+    int size;
+    int id;  // Used for internal bookkeeping
+} jsonDataBuffer_t;
+
+typedef struct
+{
+    int num_gets;         // Buffers handed out
+    int num_reuses;       // Buffers handed out from a free list
+    int num_allocations;  // Buffers that had to be allocated
+    int num_frees;        // Buffers freed instead of kept, past the cap or too large for a class
+    size_t pooled_bytes;  // Bytes of free buffers held by the pool
+    size_t peak_pooled_bytes;
+} jsonBufferStats_t;
+
+/* ***********************   Function Prototypes   ************************ */
+
+void jsonBufferInit(void);
+void jsonBufferRelease(void);
+bool jsonBufferGetBuffer(jsonDataBuffer_t *const p_buffer, const int required_size);
+void jsonBufferReturnBuffer(jsonDataBuffer_t *const p_buff);
+void jsonBufferGetStats(jsonBufferStats_t *const p_stats);
+
+#endif /* JSON_DATA_BUFFER_H */
@@ -48,6 +48,8 @@
 // Library Includes
 
 // Project Includes
+#include "utility.h"
+#include "json_number.h"
 
 // Module Includes
 #include "json_deserialization.h"
@@ -58,78 +60,247 @@
 
 /* ****************************   Structures   **************************** */
 
+// State carried along while walking the tokens of a JSON document
+typedef struct
+{
+    const jsmnTokenizationData_t *p_tok_data;
+    const char *p_json_buff;
+    int num_found; // Number of key-values deserialized so far
+} jsonWalkCtx_t;
+
+// State of a path expression search
+typedef struct
+{
+    const jsonPathExpr_t *p_expr;
+    const jsmnTokenizationData_t *p_tok_data;
+    const char *p_json_buff;
+    jsmntype_t type;
+    jsonPathMatchCbk_t *p_match_cbk;
+    void *p_cbk_ctx;
+    int num_matches;
+    bool stopped; // Set once the callback asks for the search to stop
+} jsonPathSearchCtx_t;
+
+// Search for the first match only, see jsonSearchForElement()
+typedef struct
+{
+    int tok_idx;
+} jsonFirstMatch_t;
+
 /* ***********************   Function Prototypes   ************************ */
 
 static int jsonFindKeyValueToken(const jsmnTokenizationData_t *const p_tok_data, const char *const p_json_buff,
-                                 const char *const key_str, const int key_str_len, const jsmntype_t type, const int parent_idx);
+                                 const jsonPathSegment_t *const p_segment, const jsmntype_t type, const int parent_idx);
 static void jsonDeserializeEnum(const char *const p_token_str, const int token_len,
                                 void *const p_dest, const int dest_size,
                                 const enumLabel_t *const p_enum_labels,
+                                const enumLabelIndex_t *const p_enum_index,
                                 const char *const p_key_str);
 static void jsonDeserializeString(const char *const p_token_str, const int token_len,
                                   char *const p_dest, const int dest_len);
 static void jsonDeserializePrimitive(const char *const p_token_str, const int token_len,
                                      void *const p_dest, const int dest_size, const jsonCPrimitiveType_t c_type);
+static bool jsonPathAppend(jsonPath_t *const p_path, const char *const key_str);
+static int jsonPathTrieAddChild(jsonPathTrie_t *const p_trie, const int parent_node_idx,
+                                const jsonPathSegment_t *const p_segment);
+static int jsonPathTrieFindChild(const jsonPathTrie_t *const p_trie, const int parent_node_idx,
+                                 const char *const p_js_buffer, const jsmntok_t *const p_key_tok);
+static int jsonPathTrieVisitValue(const jsonPathTrie_t *const p_trie, const int node_idx, const int value_tok_idx,
+                                  void *const p_data, bool *const p_found_keys, jsonWalkCtx_t *const p_ctx);
+static int jsonPathTrieWalkObject(const jsonPathTrie_t *const p_trie, const int node_idx, const int obj_tok_idx,
+                                  void *const p_data, bool *const p_found_keys, jsonWalkCtx_t *const p_ctx);
+static int jsonSchemaAddNode(jsonSchema_t *const p_schema, jsonContainer_t *const p_container);
+static int jsonSchemaFindChild(const jsonSchema_t *const p_schema, const int node_idx,
+                               const char *const p_js_buffer, const jsmntok_t *const p_key_tok);
+static int jsonSchemaWalkValue(const jsonSchema_t *const p_schema, const int node_idx, const int value_tok_idx,
+                               void *const p_element_data, jsonWalkCtx_t *const p_ctx);
+static int jsonSchemaWalkObject(const jsonSchema_t *const p_schema, const int node_idx, const int obj_tok_idx,
+                                void *const p_data, bool *const p_found_keys, jsonWalkCtx_t *const p_ctx);
+static int jsonSchemaWalkArray(const jsonSchema_t *const p_schema, const int node_idx, const int array_tok_idx,
+                               jsonWalkCtx_t *const p_ctx);
+static int jsonSchemaFillObjectArray(const jsonSchema_t *const p_schema, const int node_idx, const int array_tok_idx,
+                                     uint8_t *const p_dest, const size_t stride, const int max_elements,
+                                     int *const p_num_filled, jsonWalkCtx_t *const p_ctx);
+static int jsonTokenSkip(const jsmnTokenizationData_t *const p_tok_data, const int tok_idx);
+static uint32_t jsonPathExprClosure(const jsonPathExpr_t *const p_expr, uint32_t states);
+static uint32_t jsonPathExprChildStates(const jsonPathSearchCtx_t *const p_search, const uint32_t states,
+                                        const jsmntok_t *const p_key_tok, const int element_idx);
+static int jsonPathExprWalkValue(jsonPathSearchCtx_t *const p_search, const uint32_t states, const int tok_idx);
+static bool jsonFirstMatchCbk(void *p_ctx, const jsmnTokenizationData_t *const p_tok_data, const int tok_idx);
+static int jsonPathFilterKeepValue(void *p_ctx, const char *p_js_buffer, const jsmntok_t *p_tokens, int key_tok_idx);
+static bool jsonTokenMatchesSegment(const char *const p_js_buffer, const jsmntok_t *const p_tok,
+                                    const jsonPathSegment_t *const p_segment);
 
 /* ***********************   File Scope Variables   *********************** */
 
 /* *************************   Public  Functions   ************************ */
 
 // Searches for an expected object (based on a dot notation of the reference) in the json
-// data and returns a JSMN token index of that data
-// NOTE: There is no support of wildcards ('*' or '?') in the search
-// NOTE: There is no support for indexing into arrays
+// data and returns a JSMN token index of that data, or -1 if there is none.
+// The key string is a path expression (see jsonPathExprInit()), the first value matching it is returned.
+// NOTE: The key string is compiled on every call, use jsonPathExprInit() and jsonPathExprSearch()
+// NOTE: when searching for the same key many times.
 int jsonSearchForElement(const jsmnTokenizationData_t *const p_tok_data, const char *const p_json_buff, const jsonKeyValue_t *const p_key_val)
 {
-    // Check for malformed reference
-    const char *const json_ref = p_key_val->key_str;
-    const jsmntype_t type = p_key_val->value_tok_type;
-    assert((*json_ref != '\0') && (*json_ref != '.'));
+    jsonPathExpr_t expr;
+    bool expr_valid = jsonPathExprInit(&expr, p_key_val->key_str);
 
-    int current_char_idx = 0;
-    int last_element_start = 0;
+    // Malformed expressions, or ones with too many steps, can't be searched for
+    assert(expr_valid);
+
+    jsonFirstMatch_t first_match = {.tok_idx = -1};
+    if (expr_valid)
+    {
+        jsonPathExprSearch(&expr, p_tok_data, p_json_buff, p_key_val->value_tok_type, jsonFirstMatchCbk, &first_match);
+    }
+
+    return first_match.tok_idx;
+}
+
+// Splits up a dot notation key string into a path, hashing each segment
+// Returns false if there are more segments than a path can hold
+bool jsonPathInit(jsonPath_t *const p_path, const char *const key_str)
+{
+    memset(p_path, 0, sizeof(jsonPath_t));
+    return jsonPathAppend(p_path, key_str);
+}
+
+// Searches for the value at the end of a key path in the json data and returns the JSMN token index
+// of that value, or -1 if there is none of the expected type
+int jsonSearchForPath(const jsmnTokenizationData_t *const p_tok_data, const char *const p_json_buff,
+                      const jsonPath_t *const p_path, const jsmntype_t type)
+{
     // Any objects in the root start with a parent of 0
     int current_parent = 0;
-    bool element_not_found = false;
-    while ((json_ref[current_char_idx] != '\0') && !element_not_found)
+    for (int seg_idx = 0; (seg_idx < p_path->num_segments) && (current_parent != -1); seg_idx++)
+    {
+        // Every segment but the last has to lead to an object
+        const bool is_last_segment = (seg_idx == (p_path->num_segments - 1));
+        current_parent = jsonFindKeyValueToken(p_tok_data, p_json_buff, &p_path->segments[seg_idx],
+                                               (is_last_segment ? type : JSMN_OBJECT), current_parent);
+    }
+
+    return current_parent;
+}
+
+// Compiles a path expression, to be searched for with jsonPathExprSearch() any number of times.
+// Dot separated keys like jsonPathInit(), with these additions:
+//   "key[n]"   nth element (from 0) of the array at "key", "[n]" on its own is an element of the root array
+//   "key[*]"   every element of the array at "key"
+//   "**"       any number of keys and array elements, including none (i.e. "**.games" is "games" anywhere)
+// Suffixes can be chained, "key[0][*]" is every element of the first array in the array at "key".
+// Returns false if the expression is malformed or has more than JSON_PATH_EXPR_MAX_STEPS steps.
+bool jsonPathExprInit(jsonPathExpr_t *const p_expr, const char *const expr_str)
+{
+    memset(p_expr, 0, sizeof(jsonPathExpr_t));
+
+    int char_idx = 0;
+    bool segment_start = true; // At the start of the expression, or right after a '.'
+    bool valid = true;
+    while (valid && (expr_str[char_idx] != '\0'))
     {
-        // Look to see if current character is a '.'
-        if (json_ref[current_char_idx] == '.')
+        const char *const p_char = &expr_str[char_idx];
+        jsonPathStep_t step = {.type = E_JSON_PATH_STEP_KEY, .index = 0};
+
+        if (*p_char == '.')
+        {
+            // Segments can't be empty
+            valid = !segment_start;
+            segment_start = true;
+            char_idx++;
+        }
+        else
         {
-            // Found the end of the current reference
-            // Form a string, and search for a token with the required parent
-            int idx_of_value = jsonFindKeyValueToken(p_tok_data, p_json_buff, (json_ref + last_element_start), (current_char_idx - last_element_start), JSMN_OBJECT, current_parent);
-            if (idx_of_value != -1)
+            if (*p_char == '[')
             {
-                current_parent = idx_of_value;
-                // Save off an index one after the '.' character
-                last_element_start = (current_char_idx + 1);
+                // "[*]" or "[n]"
+                const int len = (int)strcspn(&p_char[1], "]");
+                int64_t index = 0;
+                if ((len == 1) && (p_char[1] == '*'))
+                {
+                    step.type = E_JSON_PATH_STEP_ANY_INDEX;
+                }
+                else
+                {
+                    step.type = E_JSON_PATH_STEP_INDEX;
+                    valid = jsonNumberParseInt(&p_char[1], len, 0, INT32_MAX, &index);
+                    step.index = (int)index;
+                }
+                valid = valid && (p_char[1 + len] == ']');
+                char_idx += (len + 2);
+            }
+            else if (segment_start && (strncmp(p_char, "**", 2) == 0) && ((p_char[2] == '.') || (p_char[2] == '\0')))
+            {
+                step.type = E_JSON_PATH_STEP_ANY_DEPTH;
+                char_idx += 2;
             }
             else
             {
-                element_not_found = true;
+                // Keys only ever start a segment, "[n]" and "[*]" are the only things that can follow one
+                const int len = (int)strcspn(p_char, ".[");
+                valid = segment_start;
+                step.key.str = p_char;
+                step.key.len = len;
+                step.key.hash = jsmn_hash(p_char, len);
+                char_idx += len;
             }
+
+            valid = valid && (p_expr->num_steps < JSON_PATH_EXPR_MAX_STEPS);
+            if (valid)
+            {
+                p_expr->steps[p_expr->num_steps++] = step;
+            }
+            segment_start = false;
         }
+    }
 
-         // Assume is part of the next reference and keep going
-        current_char_idx++;
+    // Can't end on a '.'
+    valid = valid && !(segment_start && (char_idx > 0));
+    if (!valid)
+    {
+        JSON_DEBUG_MSG("Malformed path expression: \"%s\"\n", expr_str);
+        p_expr->num_steps = 0;
     }
 
-    int final_value_idx = -1;
-    if (!element_not_found)
+    return valid;
+}
+
+// Goes through the tokens once, depth first, and calls p_match_cbk for every value that matches a path expression.
+// Objects and arrays that can't lead to a match are skipped over without looking inside of them.
+// type: Type of the values to match, JSMN_UNDEFINED for any
+// Returns the number of values that matched.
+int jsonPathExprSearch(const jsonPathExpr_t *const p_expr, const jsmnTokenizationData_t *const p_tok_data,
+                       const char *const p_json_buff, const jsmntype_t type,
+                       jsonPathMatchCbk_t *const p_match_cbk, void *const p_cbk_ctx)
+{
+    jsonPathSearchCtx_t search =
+        {
+            .p_expr = p_expr,
+            .p_tok_data = p_tok_data,
+            .p_json_buff = p_json_buff,
+            .type = type,
+            .p_match_cbk = p_match_cbk,
+            .p_cbk_ctx = p_cbk_ctx,
+            .num_matches = 0,
+            .stopped = false,
+        };
+
+    // The root value is at the first step
+    if (p_tok_data->num_tokens > 0)
     {
-        // The last search is for the final element in the string
-        final_value_idx = jsonFindKeyValueToken(p_tok_data, p_json_buff, (json_ref + last_element_start), (current_char_idx - last_element_start), type, current_parent);
+        jsonPathExprWalkValue(&search, jsonPathExprClosure(p_expr, 1u), 0);
     }
 
-    return final_value_idx;
+    return search.num_matches;
 }
 
 // Routes a token to be deserialized into a destination (p_data) based on the data in the key-value
 // table and the information in the passed token (p_value_tok)
+// p_string_cache[in]: Optional. String pointers (E_JSON_C_STR_PTR) then point to the decoded strings.
 void jsonDeserializeElement(const jsonKeyValue_t *const p_key_value,
                                    const jsmntok_t *const p_value_tok,
-                                   const char *const p_js_buffer, void *const p_data)
+                                   const char *const p_js_buffer, jsonStringCache_t *const p_string_cache,
+                                   void *const p_data)
 {
     int token_len = (p_value_tok->end - p_value_tok->start);
     const char *p_token_str = (p_js_buffer + p_value_tok->start);
@@ -149,14 +320,14 @@ void jsonDeserializeElement(const jsonKeyValue_t *const p_key_value,
                                     (((uint8_t *)p_data) + p_key_value->struct_member_offset),
                                     p_key_value->struct_member_size,
                                     p_key_value->enum_labels,
+                                    p_key_value->enum_index,
                                     p_key_value->key_str);
             }
             else if (p_key_value->c_type == E_JSON_C_STR_PTR)
             {
                 // Deserialize right here to the string pointer datatype
                 jsonStr_t *str = (jsonStr_t *)(((uint8_t *)p_data) + p_key_value->struct_member_offset);
-                str->str = p_token_str;
-                str->len = token_len;
+                *str = jsonStringCacheGet(p_string_cache, p_js_buffer, p_value_tok);
             }
             else
             {
@@ -183,30 +354,1031 @@ void jsonDeserializeElement(const jsonKeyValue_t *const p_key_value,
     }
 }
 
+// Sets up an empty token arena, nothing is allocated until the first tokenization
+void jsonTokenArenaInit(jsonTokenArena_t *const p_arena)
+{
+    memset(p_arena, 0, sizeof(jsonTokenArena_t));
+    jsonStringCacheInit(&p_arena->strings);
+}
+
+// Tokenizes JSON data into the arena's token storage, growing the storage if all of the tokens don't fit.
+// p_filter[in]: Optional, can be NULL. Limits the tokens produced to the paths in the filter.
+// p_tok_data[out]: Points to the tokens in the arena, which are valid until the next tokenization.
+// Returns false if the data could not be tokenized.
+bool jsonTokenArenaTokenize(jsonTokenArena_t *const p_arena, const char *const p_json_buff, const size_t json_len,
+                            const jsonPathFilter_t *const p_filter, jsmnTokenizationData_t *const p_tok_data)
+{
+    memset(p_tok_data, 0, sizeof(jsmnTokenizationData_t));
+
+    int jsmn_result = JSMN_ERROR_NOMEM;
+    bool tokenization_failed = false;
+    while (!tokenization_failed && (jsmn_result == JSMN_ERROR_NOMEM))
+    {
+        if (p_arena->p_tokens != NULL)
+        {
+            jsmn_parser parser;
+            jsmn_init(&parser);
+            jsonPathFilterAttach(&parser, p_filter);
+            jsmn_result = jsmn_parse(&parser, p_json_buff, json_len, p_arena->p_tokens, p_arena->capacity);
+        }
+
+        if (jsmn_result == JSMN_ERROR_NOMEM)
+        {
+            // Double the number of tokens and try again. Nothing in the old storage is needed, it goes back to the
+            // pool. The new storage is a whole size class, which can fit more tokens than asked for.
+            int new_capacity = (p_arena->capacity > 0) ? (p_arena->capacity * 2) : JSON_TOKEN_ARENA_DEFAULT_CAPACITY;
+            jsonBufferReturnBuffer(&p_arena->token_buffer);
+            jsonBufferGetBuffer(&p_arena->token_buffer, (int)(new_capacity * sizeof(jsmntok_t)));
+            p_arena->p_tokens = (jsmntok_t *)p_arena->token_buffer.p_buff;
+            p_arena->capacity = (p_arena->token_buffer.size / (int)sizeof(jsmntok_t));
+            p_arena->num_reallocations++;
+            tokenization_failed = (p_arena->p_tokens == NULL);
+        }
+        else if (jsmn_result < 0)
+        {
+            // All other JSMN errors are unrecoverable
+            JSON_DEBUG_MSG("Unable to tokenize JSON data (%d)\n", jsmn_result);
+            tokenization_failed = true;
+        }
+    }
+
+    if (!tokenization_failed)
+    {
+        p_tok_data->num_tokens = jsmn_result;
+        p_tok_data->p_tokens = p_arena->p_tokens;
+
+        // Strings decoded out of the previous JSON data are no longer needed
+        jsonStringCacheReset(&p_arena->strings);
+        p_tok_data->p_string_cache = &p_arena->strings;
+
+        p_arena->num_tokenizations++;
+        p_arena->peak_tokens = MAX(p_arena->peak_tokens, jsmn_result);
+    }
+
+    return !tokenization_failed;
+}
+
+// Frees the arena's decoded string storage, and returns its token storage to the pool. The stats are kept.
+void jsonTokenArenaDestroy(jsonTokenArena_t *const p_arena)
+{
+    jsonStringCacheDestroy(&p_arena->strings);
+    jsonBufferReturnBuffer(&p_arena->token_buffer);
+    p_arena->p_tokens = NULL;
+    p_arena->capacity = 0;
+}
+
+// Compiles a table of key-values into a trie of its key paths
+// Returns false if the table does not fit in the trie, or if two entries of the table have the same key path.
+bool jsonPathTrieInit(jsonPathTrie_t *const p_trie, const jsonKeyValue_t *const p_keys, const int num_keys)
+{
+    memset(p_trie, 0, sizeof(jsonPathTrie_t));
+    p_trie->p_keys = p_keys;
+    p_trie->num_keys = num_keys;
+
+    // Root node, stands for the object being deserialized
+    p_trie->nodes[0].first_child = -1;
+    p_trie->nodes[0].next_sibling = -1;
+    p_trie->nodes[0].key_value_idx = -1;
+    p_trie->nodes[0].num_key_values = 0;
+    p_trie->num_nodes = 1;
+
+    bool fits = true;
+    for (int key_idx = 0; (key_idx < num_keys) && fits; key_idx++)
+    {
+        jsonPath_t path;
+        fits = jsonPathInit(&path, p_keys[key_idx].key_str);
+
+        // Walk down the trie, adding the nodes that are not there yet
+        int path_nodes[JSON_MAX_PATH_SEGMENTS + 1] = {0};
+        int node_idx = 0;
+        for (int seg_idx = 0; (seg_idx < path.num_segments) && fits; seg_idx++)
+        {
+            node_idx = jsonPathTrieAddChild(p_trie, node_idx, &path.segments[seg_idx]);
+            fits = (node_idx != -1);
+            path_nodes[seg_idx + 1] = node_idx;
+        }
+
+        if (fits)
+        {
+            // The same key twice in the table, only one of them could ever be deserialized
+            assert(p_trie->nodes[node_idx].key_value_idx == -1);
+            fits = (p_trie->nodes[node_idx].key_value_idx == -1);
+            p_trie->nodes[node_idx].key_value_idx = key_idx;
+
+            // Count the key path in every node on its way, so walks know when there is nothing left to find
+            for (int seg_idx = 0; seg_idx <= path.num_segments; seg_idx++)
+            {
+                p_trie->nodes[path_nodes[seg_idx]].num_key_values++;
+            }
+        }
+    }
+
+    if (!fits)
+    {
+        JSON_DEBUG_MSG("Key table does not fit in a path trie\n");
+        p_trie->num_nodes = 0;
+    }
+
+    return fits;
+}
+
+// Deserializes every value of the trie's key-value table found in the object, into p_data.
+// The object must be the root of the token data. The object's tokens are walked once, depth-first,
+// only descending into the objects that lead to one of the key paths, and only until all of them have been found.
+// p_found_keys[out]: Optional, can be NULL. Cleared, then set to true for every entry of the table deserialized.
+// Returns the number of entries of the key-value table that were found and deserialized.
+int jsonPathTrieDeserialize(const jsonPathTrie_t *const p_trie, const jsmnTokenizationData_t *const p_tok_data,
+                            const char *const p_json_buff, void *const p_data, bool *const p_found_keys)
+{
+    if (p_found_keys != NULL)
+    {
+        memset(p_found_keys, 0, (sizeof(bool) * p_trie->num_keys));
+    }
+
+    jsonWalkCtx_t walk_ctx = {.p_tok_data = p_tok_data, .p_json_buff = p_json_buff, .num_found = 0};
+    if ((p_trie->num_nodes > 0) && (p_tok_data->num_tokens > 0) && (p_tok_data->p_tokens[0].type == JSMN_OBJECT))
+    {
+        jsonPathTrieWalkObject(p_trie, 0, 0, p_data, p_found_keys, &walk_ctx);
+    }
+
+    return walk_ctx.num_found;
+}
+
+// Goes through the keys of a table that were not found in an object, as reported by the deserializers
+// p_found_keys[in]: Entry for every key of the table, true if it was found
+// p_missing[out]: Optional, can be NULL. Which keys are missing.
+// Returns false if any key that is not marked `optional` is missing.
+bool jsonCheckRequiredKeys(const jsonKeyValue_t *const p_keys, const int num_keys, const bool *const p_found_keys,
+                           jsonMissingKeys_t *const p_missing)
+{
+    jsonMissingKeys_t missing = {.num_missing_required = 0, .num_missing_optional = 0, .first_missing_idx = -1};
+    for (int idx = 0; idx < num_keys; idx++)
+    {
+        if (!p_found_keys[idx] && p_keys[idx].optional)
+        {
+            missing.num_missing_optional++;
+        }
+        else if (!p_found_keys[idx])
+        {
+            missing.first_missing_idx = (missing.first_missing_idx == -1) ? idx : missing.first_missing_idx;
+            missing.num_missing_required++;
+        }
+    }
+
+    if (p_missing != NULL)
+    {
+        *p_missing = missing;
+    }
+
+    return (missing.num_missing_required == 0);
+}
+
+// Compiles a tree of containers into a schema that can be deserialized in a single pass over the tokens.
+// Object containers have their key lists compiled into path tries, so keys of the list can be dot notation paths.
+// Returns false if the tree does not fit in the schema, or if a key list does not fit in a trie.
+// NOTE: The schema points to the containers, which must outlive it. The containers' `p_data`
+// NOTE: and `num_elements` can still be changed after compiling (i.e. to point at a new destination array).
+bool jsonSchemaInit(jsonSchema_t *const p_schema, jsonContainer_t *const p_root)
+{
+    memset(p_schema, 0, sizeof(jsonSchema_t));
+    bool fits = (jsonSchemaAddNode(p_schema, p_root) != -1);
+    if (!fits)
+    {
+        JSON_DEBUG_MSG("Container tree does not fit in a schema\n");
+        p_schema->num_nodes = 0;
+    }
+
+    return fits;
+}
+
+// Deserializes the tokens following the schema in a single depth-first pass, filling the data of each container.
+//
+// * Object containers are filled through their key lists, into their `p_data`. When an object is
+//   the element of an array, it is filled into the array's element instead, and its `p_deserialized_elements`
+//   holds one found-key bitmap per element (see jsonDeserializeArray()).
+// * Array containers are filled one element after the other into their `p_data`, each `element_size` apart.
+//   The number of elements filled is written to `num_elements_deserialized`. Arrays that show up more
+//   than once (i.e. "games" in every object of "dates") are appended to, so the elements end up in document order.
+//   Elements that do not fit in `num_elements` are dropped.
+// * An array with `element_size` set and a NULL `p_data` only counts its elements. This can be used to size
+//   the destination before deserializing again.
+// * An array with an `element_size` of 0 stores nothing, its elements are only walked through
+//   (i.e. to get to the arrays inside of them).
+//
+// Returns the number of key-values that were deserialized.
+int jsonDeserializeSchema(const jsonSchema_t *const p_schema, const jsmnTokenizationData_t *const p_tok_data,
+                          const char *const p_json_buff)
+{
+    jsonWalkCtx_t walk_ctx = {.p_tok_data = p_tok_data, .p_json_buff = p_json_buff, .num_found = 0};
+
+    // Every array starts empty
+    for (int idx = 0; idx < p_schema->num_nodes; idx++)
+    {
+        if (p_schema->nodes[idx].p_container->type == E_JSON_ARRAY)
+        {
+            p_schema->nodes[idx].p_container->num_elements_deserialized = 0;
+        }
+    }
+
+    if ((p_schema->num_nodes > 0) && (p_tok_data->num_tokens > 0))
+    {
+        jsonSchemaWalkValue(p_schema, 0, 0, NULL, &walk_ctx);
+    }
+
+    return walk_ctx.num_found;
+}
+
+// Deserializes all of the objects of an array in one call, into a contiguous destination.
+// p_element_schema[in]: Schema compiled (jsonSchemaInit()) from the E_JSON_OBJECT container that describes an element.
+//                       Compiled once, it is reused for every element and every call. The container's `p_data` is not used.
+// array_tok_idx: Index of the JSMN_ARRAY token
+// p_dest[out]: First element of the destination. Anything in the array that is not an object is skipped.
+// stride: Number of bytes from one element of the destination to the next
+// max_elements: Number of elements in the destination, objects that do not fit are dropped
+// When the element container has `p_deserialized_elements`, it receives one found-key bitmap per element (element n
+// at p_deserialized_elements[n * p_key_list->size]), and must hold (max_elements * p_key_list->size) entries.
+// Returns the number of elements filled.
+int jsonDeserializeArray(const jsonSchema_t *const p_element_schema, const jsmnTokenizationData_t *const p_tok_data,
+                         const char *const p_json_buff, const int array_tok_idx, void *const p_dest,
+                         const size_t stride, const int max_elements)
+{
+    int num_filled = 0;
+    if ((p_element_schema->num_nodes > 0) && (p_element_schema->nodes[0].p_container->type == E_JSON_OBJECT) &&
+        (array_tok_idx >= 0) && (array_tok_idx < p_tok_data->num_tokens) &&
+        (p_tok_data->p_tokens[array_tok_idx].type == JSMN_ARRAY))
+    {
+        jsonWalkCtx_t walk_ctx = {.p_tok_data = p_tok_data, .p_json_buff = p_json_buff, .num_found = 0};
+        jsonSchemaFillObjectArray(p_element_schema, 0, array_tok_idx, (uint8_t *)p_dest, stride, max_elements,
+                                  &num_filled, &walk_ctx);
+    }
+
+    return num_filled;
+}
+
+// Deserializes a single object found anywhere in the tokens (i.e. one element of an array) into p_dest.
+// p_schema[in]: Schema compiled from the E_JSON_OBJECT container that describes the object, as for jsonDeserializeArray()
+// obj_tok_idx: Index of the JSMN_OBJECT token
+// p_found_keys[out]: Optional, can be NULL. One entry per key of the container's key list, the container's own
+//                    `p_deserialized_elements` is not used.
+// Nothing is written to the schema or its containers when the schema has no child containers, so several threads can
+// deserialize objects with the same schema at once, provided each one has its own string cache in p_tok_data.
+// Returns the number of key-values that were deserialized.
+int jsonDeserializeObject(const jsonSchema_t *const p_schema, const jsmnTokenizationData_t *const p_tok_data,
+                          const char *const p_json_buff, const int obj_tok_idx, void *const p_dest,
+                          bool *const p_found_keys)
+{
+    jsonWalkCtx_t walk_ctx = {.p_tok_data = p_tok_data, .p_json_buff = p_json_buff, .num_found = 0};
+    if ((p_schema->num_nodes > 0) && (p_schema->nodes[0].p_container->type == E_JSON_OBJECT) &&
+        (obj_tok_idx >= 0) && (obj_tok_idx < p_tok_data->num_tokens) &&
+        (p_tok_data->p_tokens[obj_tok_idx].type == JSMN_OBJECT))
+    {
+        jsonSchemaWalkObject(p_schema, 0, obj_tok_idx, p_dest, p_found_keys, &walk_ctx);
+    }
+
+    return walk_ctx.num_found;
+}
+
+// Builds a path filter out of a table of key-values, so tokenizing only produces the tokens
+// that are needed to deserialize the table.
+//
+// prefix_str[in]: Optional, can be NULL. Key path prepended to every key in the table. This would be
+// the path of the array the objects described by the table live in (i.e. "dates.games").
+//
+// Returns false if the table does not fit in the filter. The filter will then be empty.
+bool jsonPathFilterInit(jsonPathFilter_t *const p_filter, const char *const prefix_str,
+                        const jsonKeyValue_t *const p_keys, const int num_keys)
+{
+    memset(p_filter, 0, sizeof(jsonPathFilter_t));
+
+    jsonPath_t prefix_path;
+    memset(&prefix_path, 0, sizeof(jsonPath_t));
+
+    bool fits = (num_keys <= JSON_PATH_FILTER_MAX_PATHS);
+    if (fits && (prefix_str != NULL))
+    {
+        fits = jsonPathAppend(&prefix_path, prefix_str);
+    }
+
+    for (int idx = 0; (idx < num_keys) && fits; idx++)
+    {
+        // Every path starts with the prefix, then the key's own segments
+        p_filter->paths[idx] = prefix_path;
+        fits = jsonPathAppend(&p_filter->paths[idx], p_keys[idx].key_str);
+    }
+
+    p_filter->num_paths = (fits ? num_keys : 0);
+    return fits;
+}
+
+// Attaches a path filter to a JSMN parser. Passing a NULL filter removes any filtering.
+// NOTE: `jsmn_init` clears the filter, so this must be called after every `jsmn_init`
+void jsonPathFilterAttach(jsmn_parser *const p_parser, const jsonPathFilter_t *const p_filter)
+{
+    jsmn_set_filter(p_parser, ((p_filter != NULL) ? jsonPathFilterKeepValue : NULL), (void *)p_filter);
+}
+
 /* *************************   Private Functions   ************************ */
 
+// Splits a dot notation key string into segments, appending them to the end of the path
+// Returns false if there are more segments than the path can hold
+static bool jsonPathAppend(jsonPath_t *const p_path, const char *const key_str)
+{
+    // Check for malformed reference
+    assert((key_str != NULL) && (*key_str != '\0') && (*key_str != '.'));
+
+    int current_char_idx = 0;
+    int last_element_start = 0;
+    bool fits = true;
+    bool at_end = false;
+    while (!at_end && fits)
+    {
+        at_end = (key_str[current_char_idx] == '\0');
+        if ((key_str[current_char_idx] == '.') || at_end)
+        {
+            fits = (p_path->num_segments < JSON_MAX_PATH_SEGMENTS);
+            if (fits)
+            {
+                jsonPathSegment_t *const p_segment = &p_path->segments[p_path->num_segments++];
+                p_segment->str = (key_str + last_element_start);
+                p_segment->len = (current_char_idx - last_element_start);
+                p_segment->hash = jsmn_hash(p_segment->str, p_segment->len);
+            }
+
+            // Save off an index one after the '.' character
+            last_element_start = (current_char_idx + 1);
+        }
+
+        current_char_idx++;
+    }
+
+    return fits;
+}
+
+// Finds the child of a trie node with the segment as its key, adding it if it is not there yet
+// Returns the index of the child node, or -1 if the trie is full
+static int jsonPathTrieAddChild(jsonPathTrie_t *const p_trie, const int parent_node_idx,
+                                const jsonPathSegment_t *const p_segment)
+{
+    int child_idx = p_trie->nodes[parent_node_idx].first_child;
+    int last_child_idx = -1;
+    while ((child_idx != -1) &&
+           !((p_trie->nodes[child_idx].segment.len == p_segment->len) &&
+             (memcmp(p_trie->nodes[child_idx].segment.str, p_segment->str, p_segment->len) == 0)))
+    {
+        last_child_idx = child_idx;
+        child_idx = p_trie->nodes[child_idx].next_sibling;
+    }
+
+    if ((child_idx == -1) && (p_trie->num_nodes < JSON_PATH_TRIE_MAX_NODES))
+    {
+        child_idx = p_trie->num_nodes++;
+        jsonPathTrieNode_t *const p_node = &p_trie->nodes[child_idx];
+        p_node->segment = *p_segment;
+        p_node->first_child = -1;
+        p_node->next_sibling = -1;
+        p_node->key_value_idx = -1;
+        p_node->num_key_values = 0;
+
+        // Keep the children in the order of the table
+        if (last_child_idx == -1)
+        {
+            p_trie->nodes[parent_node_idx].first_child = child_idx;
+        }
+        else
+        {
+            p_trie->nodes[last_child_idx].next_sibling = child_idx;
+        }
+    }
+
+    return child_idx;
+}
+
+// Finds the child of a trie node that matches a key token
+// Returns the index of the child node, or -1 if the key is not of interest
+static int jsonPathTrieFindChild(const jsonPathTrie_t *const p_trie, const int parent_node_idx,
+                                 const char *const p_js_buffer, const jsmntok_t *const p_key_tok)
+{
+    int child_idx = p_trie->nodes[parent_node_idx].first_child;
+    while ((child_idx != -1) && !jsonTokenMatchesSegment(p_js_buffer, p_key_tok, &p_trie->nodes[child_idx].segment))
+    {
+        child_idx = p_trie->nodes[child_idx].next_sibling;
+    }
+
+    return child_idx;
+}
+
+// Handles the value of a key that matched a trie node: deserializes it if a key path ends at the node,
+// or walks into it if the node is on the way to other key paths.
+// p_found_keys[out]: Optional, can be NULL. Set to true for every entry of the key-value table deserialized.
+// Returns the index of the token following the value (and everything inside of it).
+static int jsonPathTrieVisitValue(const jsonPathTrie_t *const p_trie, const int node_idx, const int value_tok_idx,
+                                  void *const p_data, bool *const p_found_keys, jsonWalkCtx_t *const p_ctx)
+{
+    const jsonPathTrieNode_t *const p_node = &p_trie->nodes[node_idx];
+    const jsmntok_t *const p_value_tok = &p_ctx->p_tok_data->p_tokens[value_tok_idx];
+
+    if ((p_node->key_value_idx != -1) && (p_value_tok->type == p_trie->p_keys[p_node->key_value_idx].value_tok_type))
+    {
+        jsonDeserializeElement(&p_trie->p_keys[p_node->key_value_idx], p_value_tok, p_ctx->p_json_buff,
+                               p_ctx->p_tok_data->p_string_cache, p_data);
+        p_ctx->num_found++;
+        if (p_found_keys != NULL)
+        {
+            p_found_keys[p_node->key_value_idx] = true;
+        }
+    }
+
+    int next_tok_idx;
+    if ((p_node->first_child != -1) && (p_value_tok->type == JSMN_OBJECT))
+    {
+        next_tok_idx = jsonPathTrieWalkObject(p_trie, node_idx, value_tok_idx, p_data, p_found_keys, p_ctx);
+    }
+    else
+    {
+        // Value was not walked, step over it
+        next_tok_idx = jsonTokenSkip(p_ctx->p_tok_data, value_tok_idx);
+    }
+
+    return next_tok_idx;
+}
+
+// Goes through the keys of an object, deserializing the values at the end of a key path and descending into
+// the objects on the way to one. Everything else is skipped over.
+// Returns the index of the token following the object (and everything inside of it).
+static int jsonPathTrieWalkObject(const jsonPathTrie_t *const p_trie, const int node_idx, const int obj_tok_idx,
+                                  void *const p_data, bool *const p_found_keys, jsonWalkCtx_t *const p_ctx)
+{
+    const jsmnTokenizationData_t *const p_tok_data = p_ctx->p_tok_data;
+    const int num_keys = p_tok_data->p_tokens[obj_tok_idx].size;
+
+    // Key paths that end below the node, once they have all been found the rest of the object is of no interest
+    const jsonPathTrieNode_t *const p_node = &p_trie->nodes[node_idx];
+    const int num_wanted = (p_node->num_key_values - ((p_node->key_value_idx != -1) ? 1 : 0));
+    const int num_found_before = p_ctx->num_found;
+    bool all_found = false;
+
+    int tok_idx = (obj_tok_idx + 1);
+    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < p_tok_data->num_tokens) && !all_found; idx++)
+    {
+        // Every key is followed by its value
+        const int value_tok_idx = (tok_idx + 1);
+        const int child_idx = jsonPathTrieFindChild(p_trie, node_idx, p_ctx->p_json_buff, &p_tok_data->p_tokens[tok_idx]);
+
+        if (child_idx != -1)
+        {
+            tok_idx = jsonPathTrieVisitValue(p_trie, child_idx, value_tok_idx, p_data, p_found_keys, p_ctx);
+        }
+        else
+        {
+            // Not on any key path, step over it to the next key
+            tok_idx = jsonTokenSkip(p_tok_data, value_tok_idx);
+        }
+
+        all_found = ((p_ctx->num_found - num_found_before) >= num_wanted);
+    }
+
+    if (all_found && (tok_idx < p_tok_data->num_tokens) &&
+        (p_tok_data->p_tokens[tok_idx].start < p_tok_data->p_tokens[obj_tok_idx].end))
+    {
+        // Step over the keys that were not looked at
+        tok_idx = jsonTokenSkip(p_tok_data, obj_tok_idx);
+    }
+
+    return tok_idx;
+}
+
+// Adds a container and all of its children to the schema
+// Returns the index of the container's node, or -1 if the schema is full
+static int jsonSchemaAddNode(jsonSchema_t *const p_schema, jsonContainer_t *const p_container)
+{
+    int node_idx = -1;
+    if (p_schema->num_nodes < JSON_SCHEMA_MAX_NODES)
+    {
+        node_idx = p_schema->num_nodes++;
+        jsonSchemaNode_t *const p_node = &p_schema->nodes[node_idx];
+        p_node->p_container = p_container;
+        p_node->first_child = -1;
+        p_node->next_sibling = -1;
+
+        // Containers without a name are never looked up by key
+        if ((p_container->key_str != NULL) && (*p_container->key_str != '\0'))
+        {
+            p_node->key.str = p_container->key_str;
+            p_node->key.len = (int)strlen(p_container->key_str);
+            p_node->key.hash = jsmn_hash(p_node->key.str, p_node->key.len);
+        }
+
+        bool fits = true;
+        if ((p_container->type == E_JSON_OBJECT) && (p_container->p_key_list != NULL))
+        {
+            fits = jsonPathTrieInit(&p_node->key_trie, p_container->p_key_list->p_keys, p_container->p_key_list->size);
+        }
+
+        // Children are linked in the order they are listed
+        int last_child_idx = -1;
+        for (int idx = 0; (idx < p_container->num_children) && fits; idx++)
+        {
+            const int child_idx = jsonSchemaAddNode(p_schema, p_container->children[idx]);
+            fits = (child_idx != -1);
+            if (fits)
+            {
+                if (last_child_idx == -1)
+                {
+                    p_schema->nodes[node_idx].first_child = child_idx;
+                }
+                else
+                {
+                    p_schema->nodes[last_child_idx].next_sibling = child_idx;
+                }
+                last_child_idx = child_idx;
+            }
+        }
+
+        node_idx = (fits ? node_idx : -1);
+    }
+
+    return node_idx;
+}
+
+// Finds the child container of an object that matches a key token
+// Returns the index of the child's node, or -1 if no child has that key
+static int jsonSchemaFindChild(const jsonSchema_t *const p_schema, const int node_idx,
+                               const char *const p_js_buffer, const jsmntok_t *const p_key_tok)
+{
+    int child_idx = p_schema->nodes[node_idx].first_child;
+    while ((child_idx != -1) &&
+           ((p_schema->nodes[child_idx].key.len == 0) ||
+            !jsonTokenMatchesSegment(p_js_buffer, p_key_tok, &p_schema->nodes[child_idx].key)))
+    {
+        child_idx = p_schema->nodes[child_idx].next_sibling;
+    }
+
+    return child_idx;
+}
+
+// Walks a value with the container of a schema node, if the value is of the container's type
+// p_element_data[in]: Destination of an object that is the element of an array, NULL to use the container's own `p_data`
+// Returns the index of the token following the value (and everything inside of it).
+static int jsonSchemaWalkValue(const jsonSchema_t *const p_schema, const int node_idx, const int value_tok_idx,
+                               void *const p_element_data, jsonWalkCtx_t *const p_ctx)
+{
+    const jsonContainer_t *const p_container = p_schema->nodes[node_idx].p_container;
+    const jsmntype_t value_type = p_ctx->p_tok_data->p_tokens[value_tok_idx].type;
+
+    int next_tok_idx;
+    if ((p_container->type == E_JSON_OBJECT) && (value_type == JSMN_OBJECT))
+    {
+        next_tok_idx = jsonSchemaWalkObject(p_schema, node_idx, value_tok_idx,
+                                            ((p_element_data != NULL) ? p_element_data : p_container->p_data),
+                                            p_container->p_deserialized_elements, p_ctx);
+    }
+    else if ((p_container->type == E_JSON_ARRAY) && (value_type == JSMN_ARRAY))
+    {
+        next_tok_idx = jsonSchemaWalkArray(p_schema, node_idx, value_tok_idx, p_ctx);
+    }
+    else
+    {
+        // Not what the schema expects, nothing to deserialize
+        JSON_TRACE_MSG("Unexpected token type %d for container %s\n", value_type,
+                       ((p_container->key_str != NULL) ? p_container->key_str : "(root)"));
+        next_tok_idx = jsonTokenSkip(p_ctx->p_tok_data, value_tok_idx);
+    }
+
+    return next_tok_idx;
+}
+
+// Goes through the keys of an object once, handing each value to the object's key list and/or the
+// child container with the matching key. Values neither are interested in are skipped over.
+// p_found_keys[out]: Optional, can be NULL. Cleared, then set to true for every entry of the key list found.
+// Returns the index of the token following the object (and everything inside of it).
+static int jsonSchemaWalkObject(const jsonSchema_t *const p_schema, const int node_idx, const int obj_tok_idx,
+                                void *const p_data, bool *const p_found_keys, jsonWalkCtx_t *const p_ctx)
+{
+    const jsonSchemaNode_t *const p_node = &p_schema->nodes[node_idx];
+    const jsmnTokenizationData_t *const p_tok_data = p_ctx->p_tok_data;
+    const int num_keys = p_tok_data->p_tokens[obj_tok_idx].size;
+
+    // Keys are reported found per object
+    if ((p_found_keys != NULL) && (p_node->p_container->p_key_list != NULL))
+    {
+        memset(p_found_keys, 0, (sizeof(bool) * p_node->p_container->p_key_list->size));
+    }
+
+    int tok_idx = (obj_tok_idx + 1);
+
+    // A generated deserializer takes care of the whole object, when there are no child containers to visit
+    if ((p_node->p_container->p_deserializer != NULL) && (p_node->first_child == -1) && (p_data != NULL))
+    {
+        tok_idx = p_node->p_container->p_deserializer(p_tok_data->p_tokens, p_tok_data->num_tokens, obj_tok_idx,
+                                                      p_ctx->p_json_buff, p_tok_data->p_string_cache, p_data,
+                                                      p_found_keys, &p_ctx->num_found);
+    }
+    else
+    {
+        // Without a destination there is nowhere to put the key list's values
+        const bool has_key_list = (p_node->key_trie.num_nodes > 0) && (p_data != NULL);
+
+        // Without child containers to look for, the object is done with once the whole key list has been found
+        const bool can_end_early = has_key_list && (p_node->first_child == -1);
+        const int num_found_before = p_ctx->num_found;
+        bool all_found = false;
+
+        for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < p_tok_data->num_tokens) && !all_found; idx++)
+        {
+            const jsmntok_t *const p_key_tok = &p_tok_data->p_tokens[tok_idx];
+            const int value_tok_idx = (tok_idx + 1);
+            const int trie_node_idx = has_key_list ? jsonPathTrieFindChild(&p_node->key_trie, 0, p_ctx->p_json_buff, p_key_tok) : -1;
+            const int child_idx = jsonSchemaFindChild(p_schema, node_idx, p_ctx->p_json_buff, p_key_tok);
+
+            // Both walks end up at the same token
+            tok_idx = -1;
+            if (trie_node_idx != -1)
+            {
+                tok_idx = jsonPathTrieVisitValue(&p_node->key_trie, trie_node_idx, value_tok_idx, p_data, p_found_keys, p_ctx);
+            }
+
+            if (child_idx != -1)
+            {
+                tok_idx = jsonSchemaWalkValue(p_schema, child_idx, value_tok_idx, NULL, p_ctx);
+            }
+
+            if (tok_idx == -1)
+            {
+                tok_idx = jsonTokenSkip(p_tok_data, value_tok_idx);
+            }
+
+            all_found = can_end_early && ((p_ctx->num_found - num_found_before) >= p_node->key_trie.nodes[0].num_key_values);
+        }
+
+        if (all_found && (tok_idx < p_tok_data->num_tokens) &&
+            (p_tok_data->p_tokens[tok_idx].start < p_tok_data->p_tokens[obj_tok_idx].end))
+        {
+            // Step over the keys that were not looked at
+            tok_idx = jsonTokenSkip(p_tok_data, obj_tok_idx);
+        }
+    }
+
+    return tok_idx;
+}
+
+// Goes through the elements of an array, storing each one into the container's data array.
+// Objects and arrays in the array are handed to the container's child.
+// Returns the index of the token following the array (and everything inside of it).
+static int jsonSchemaWalkArray(const jsonSchema_t *const p_schema, const int node_idx, const int array_tok_idx,
+                               jsonWalkCtx_t *const p_ctx)
+{
+    const jsonSchemaNode_t *const p_node = &p_schema->nodes[node_idx];
+    jsonContainer_t *const p_container = p_node->p_container;
+    const jsmnTokenizationData_t *const p_tok_data = p_ctx->p_tok_data;
+    const int num_elements = p_tok_data->p_tokens[array_tok_idx].size;
+
+    // Used to deserialize arrays of strings and primitives, each element is a "member" at offset 0
+    const jsonKeyValue_t element_key_value =
+        {
+            .key_str = p_container->key_str,
+            .struct_member_offset = 0,
+            .struct_member_size = p_container->element_size,
+            .value_tok_type = p_container->value_tok_type,
+            .c_type = p_container->c_type,
+            .enum_labels = p_container->enum_labels,
+            .enum_index = p_container->enum_index,
+        };
+
+    // Arrays of objects are filled the same way jsonDeserializeArray() does it
+    const bool fills_objects = (p_container->value_tok_type == JSMN_OBJECT) && (p_container->element_size > 0) &&
+                               (p_container->p_data != NULL) && (p_node->first_child != -1) &&
+                               (p_schema->nodes[p_node->first_child].p_container->type == E_JSON_OBJECT);
+
+    int tok_idx = (array_tok_idx + 1);
+    if (fills_objects)
+    {
+        tok_idx = jsonSchemaFillObjectArray(p_schema, p_node->first_child, array_tok_idx, (uint8_t *)p_container->p_data,
+                                            (size_t)p_container->element_size, p_container->num_elements,
+                                            &p_container->num_elements_deserialized, p_ctx);
+    }
+    else
+    {
+        for (int idx = 0; (idx < num_elements) && (tok_idx < p_tok_data->num_tokens); idx++)
+        {
+            const jsmntok_t *const p_element_tok = &p_tok_data->p_tokens[tok_idx];
+            const bool stores_elements = (p_container->element_size > 0);
+
+            // Where the element goes, NULL if it is not stored
+            void *p_element_data = NULL;
+            bool element_wanted = (p_element_tok->type == p_container->value_tok_type);
+            if (element_wanted && stores_elements)
+            {
+                if (p_container->p_data == NULL)
+                {
+                    // Only counting the elements
+                    p_container->num_elements_deserialized++;
+                    element_wanted = false;
+                }
+                else if (p_container->num_elements_deserialized < p_container->num_elements)
+                {
+                    p_element_data = ((uint8_t *)p_container->p_data +
+                                      (p_container->num_elements_deserialized * p_container->element_size));
+                    p_container->num_elements_deserialized++;
+                }
+                else
+                {
+                    JSON_DEBUG_MSG("Array %s is full, element %d dropped\n",
+                                   ((p_container->key_str != NULL) ? p_container->key_str : "(root)"), idx);
+                    element_wanted = false;
+                }
+            }
+
+            const int next_tok_idx = tok_idx;
+            tok_idx = -1;
+            if (element_wanted && ((p_element_tok->type == JSMN_OBJECT) || (p_element_tok->type == JSMN_ARRAY)))
+            {
+                // Containers in arrays are described by the first child
+                if (p_node->first_child != -1)
+                {
+                    tok_idx = jsonSchemaWalkValue(p_schema, p_node->first_child, next_tok_idx, p_element_data, p_ctx);
+                }
+            }
+            else if (element_wanted && (p_element_data != NULL))
+            {
+                jsonDeserializeElement(&element_key_value, p_element_tok, p_ctx->p_json_buff, p_tok_data->p_string_cache,
+                                       p_element_data);
+                p_ctx->num_found++;
+            }
+
+            if (tok_idx == -1)
+            {
+                tok_idx = jsonTokenSkip(p_tok_data, next_tok_idx);
+            }
+        }
+    }
+
+    return tok_idx;
+}
+
+// Fills the objects of an array into consecutive elements of a destination, `stride` bytes apart, using the
+// object container of a schema node. Anything in the array that is not an object is skipped over.
+// When the container has `p_deserialized_elements`, the found keys of the element at position n of the
+// destination are written from p_deserialized_elements[n * p_key_list->size].
+// p_num_filled[in/out]: Position of the next element to fill. Objects past max_elements are dropped.
+// Returns the index of the token following the array (and everything inside of it).
+static int jsonSchemaFillObjectArray(const jsonSchema_t *const p_schema, const int node_idx, const int array_tok_idx,
+                                     uint8_t *const p_dest, const size_t stride, const int max_elements,
+                                     int *const p_num_filled, jsonWalkCtx_t *const p_ctx)
+{
+    const jsonContainer_t *const p_container = p_schema->nodes[node_idx].p_container;
+    const jsmnTokenizationData_t *const p_tok_data = p_ctx->p_tok_data;
+    const int num_elements = p_tok_data->p_tokens[array_tok_idx].size;
+    const int num_keys = (p_container->p_key_list != NULL) ? p_container->p_key_list->size : 0;
+
+    int tok_idx = (array_tok_idx + 1);
+    for (int idx = 0; (idx < num_elements) && (tok_idx < p_tok_data->num_tokens); idx++)
+    {
+        const int element_tok_idx = tok_idx;
+        const bool is_object = (p_tok_data->p_tokens[element_tok_idx].type == JSMN_OBJECT);
+
+        if (is_object && (*p_num_filled < max_elements))
+        {
+            bool *const p_found_keys = (p_container->p_deserialized_elements != NULL) ?
+                                       &p_container->p_deserialized_elements[*p_num_filled * num_keys] : NULL;
+
+            tok_idx = jsonSchemaWalkObject(p_schema, node_idx, element_tok_idx, (p_dest + ((size_t)*p_num_filled * stride)),
+                                           p_found_keys, p_ctx);
+            (*p_num_filled)++;
+        }
+        else
+        {
+            if (is_object)
+            {
+                JSON_DEBUG_MSG("Destination array is full, element %d dropped\n", idx);
+            }
+            tok_idx = jsonTokenSkip(p_tok_data, element_tok_idx);
+        }
+    }
+
+    return tok_idx;
+}
+
+// Gets the index of the token following a value and everything inside of it
+static int jsonTokenSkip(const jsmnTokenizationData_t *const p_tok_data, const int tok_idx)
+{
+    // Anything inside of the value starts before the value ends
+    const jsmntok_t *const p_tokens = p_tok_data->p_tokens;
+    const int value_end = p_tokens[tok_idx].end;
+    int next_tok_idx = (tok_idx + 1);
+
+    if ((next_tok_idx < p_tok_data->num_tokens) && (p_tokens[next_tok_idx].start < value_end))
+    {
+        // Objects and arrays: tokens are in the order they start at, so the first one past the value
+        // can be found with a binary search, instead of going through everything inside of the value.
+        // Every token takes up at least a byte, so the search is bounded by the length of the value
+        // rather than by the rest of the document.
+        const int max_tok_idx = (next_tok_idx + (value_end - p_tokens[tok_idx].start));
+        int high_idx = min(p_tok_data->num_tokens, max_tok_idx);
+        while (next_tok_idx < high_idx)
+        {
+            const int mid_idx = next_tok_idx + ((high_idx - next_tok_idx) / 2);
+            if (p_tokens[mid_idx].start < value_end)
+            {
+                next_tok_idx = (mid_idx + 1);
+            }
+            else
+            {
+                high_idx = mid_idx;
+            }
+        }
+    }
+
+    return next_tok_idx;
+}
+
+// Path expressions are matched like a regular expression: a value is at a set of steps of the expression
+// (bit n set for step n, bit num_steps for the end of the expression), and the steps its children are at
+// follow from the key or array index leading to them. "**" can stand for nothing, so whenever it is in
+// the set, the step after it is also added.
+static uint32_t jsonPathExprClosure(const jsonPathExpr_t *const p_expr, uint32_t states)
+{
+    // Steps are only ever added after the "**" they follow, going through them in order is enough
+    for (int step_idx = 0; step_idx < p_expr->num_steps; step_idx++)
+    {
+        if (((states & (1u << step_idx)) != 0) && (p_expr->steps[step_idx].type == E_JSON_PATH_STEP_ANY_DEPTH))
+        {
+            states |= (1u << (step_idx + 1));
+        }
+    }
 
+    return states;
+}
 
-// Finds a value's token index in the list, using the known parent and the value's key string
+// Gets the steps of the expression a child value is at, from the steps its parent is at
+// p_key_tok[in]: Key of the child in an object, NULL for the elements of an array
+// element_idx: Position of the child in an array
+static uint32_t jsonPathExprChildStates(const jsonPathSearchCtx_t *const p_search, const uint32_t states,
+                                        const jsmntok_t *const p_key_tok, const int element_idx)
+{
+    const jsonPathExpr_t *const p_expr = p_search->p_expr;
+    uint32_t child_states = 0;
+    for (int step_idx = 0; step_idx < p_expr->num_steps; step_idx++)
+    {
+        if ((states & (1u << step_idx)) != 0)
+        {
+            const jsonPathStep_t *const p_step = &p_expr->steps[step_idx];
+            bool step_matches = false;
+            switch (p_step->type)
+            {
+                case E_JSON_PATH_STEP_KEY:
+                    step_matches = (p_key_tok != NULL) &&
+                                   jsonTokenMatchesSegment(p_search->p_json_buff, p_key_tok, &p_step->key);
+                    break;
+                case E_JSON_PATH_STEP_INDEX:
+                    step_matches = (p_key_tok == NULL) && (element_idx == p_step->index);
+                    break;
+                case E_JSON_PATH_STEP_ANY_INDEX:
+                    step_matches = (p_key_tok == NULL);
+                    break;
+                case E_JSON_PATH_STEP_ANY_DEPTH:
+                    // Stays at the same step, one level deeper
+                    child_states |= (1u << step_idx);
+                    break;
+                default:
+                    assert(false);
+                    break;
+            }
+            child_states |= (step_matches ? (1u << (step_idx + 1)) : 0);
+        }
+    }
+
+    return jsonPathExprClosure(p_expr, child_states);
+}
+
+// Reports a value to the callback if it is at the end of the expression, then walks through its children
+// that can still lead to a match. Returns the index of the token following the value.
+static int jsonPathExprWalkValue(jsonPathSearchCtx_t *const p_search, const uint32_t states, const int tok_idx)
+{
+    const jsmnTokenizationData_t *const p_tok_data = p_search->p_tok_data;
+    const jsmntok_t *const p_tok = &p_tok_data->p_tokens[tok_idx];
+    const uint32_t match_state = (1u << p_search->p_expr->num_steps);
+
+    if (((states & match_state) != 0) && ((p_search->type == JSMN_UNDEFINED) || (p_tok->type == p_search->type)))
+    {
+        p_search->num_matches++;
+        p_search->stopped = !p_search->p_match_cbk(p_search->p_cbk_ctx, p_tok_data, tok_idx);
+    }
+
+    int next_tok_idx;
+    const uint32_t steps_left = (states & ~match_state);
+    if ((steps_left != 0) && ((p_tok->type == JSMN_OBJECT) || (p_tok->type == JSMN_ARRAY)))
+    {
+        // Members of an object are a key followed by its value
+        const int value_offset = ((p_tok->type == JSMN_OBJECT) ? 1 : 0);
+        next_tok_idx = (tok_idx + 1);
+        for (int idx = 0; (idx < p_tok->size) && ((next_tok_idx + value_offset) < p_tok_data->num_tokens) &&
+                          !p_search->stopped; idx++)
+        {
+            const jsmntok_t *const p_key_tok = ((value_offset != 0) ? &p_tok_data->p_tokens[next_tok_idx] : NULL);
+            const int value_tok_idx = (next_tok_idx + value_offset);
+            const uint32_t value_states = jsonPathExprChildStates(p_search, steps_left, p_key_tok, idx);
+
+            next_tok_idx = ((value_states != 0) ? jsonPathExprWalkValue(p_search, value_states, value_tok_idx)
+                                                : jsonTokenSkip(p_tok_data, value_tok_idx));
+        }
+    }
+    else
+    {
+        next_tok_idx = jsonTokenSkip(p_tok_data, tok_idx);
+    }
+
+    return next_tok_idx;
+}
+
+// Path expression match callback keeping the first match only
+static bool jsonFirstMatchCbk(void *p_ctx, const jsmnTokenizationData_t *const p_tok_data, const int tok_idx)
+{
+    jsonFirstMatch_t *const p_first_match = (jsonFirstMatch_t *)p_ctx;
+    (void)p_tok_data;
+
+    p_first_match->tok_idx = tok_idx;
+    return false;
+}
+
+// JSMN filter callback, called before the value of a key is parsed.
+// Rebuilds the key path of the value (using the parent links) and keeps the value if it is on the way
+// to one of the filter's paths, or if it is inside of the value one of the paths leads to.
+static int jsonPathFilterKeepValue(void *p_ctx, const char *p_js_buffer, const jsmntok_t *p_tokens, int key_tok_idx)
+{
+    const jsonPathFilter_t *const p_filter = (const jsonPathFilter_t *)p_ctx;
+
+    // Count the keys between the value and the root. Objects and arrays in-between are not part of the path.
+    int depth = 0;
+    for (int idx = key_tok_idx; idx != -1; idx = p_tokens[idx].parent)
+    {
+        depth += (p_tokens[idx].type == JSMN_STRING) ? 1 : 0;
+    }
+
+    // Fill in the key path from the root down. Keys deeper than the longest allowed path
+    // will never be compared, so those are left out.
+    const jsmntok_t *p_key_path[JSON_MAX_PATH_SEGMENTS];
+    int segment_idx = depth;
+    for (int idx = key_tok_idx; idx != -1; idx = p_tokens[idx].parent)
+    {
+        if (p_tokens[idx].type == JSMN_STRING)
+        {
+            segment_idx--;
+            if (segment_idx < JSON_MAX_PATH_SEGMENTS)
+            {
+                p_key_path[segment_idx] = &p_tokens[idx];
+            }
+        }
+    }
+
+    bool keep = false;
+    for (int path_idx = 0; (path_idx < p_filter->num_paths) && !keep; path_idx++)
+    {
+        // Only the segments both paths have in common are compared. If those match, the value is either
+        // on the way to the filter path, or the filter path ends in an object/array the value is a part of.
+        const jsonPath_t *const p_path = &p_filter->paths[path_idx];
+        const int num_segments_to_compare = min(depth, p_path->num_segments);
+
+        keep = true;
+        for (int seg_idx = 0; (seg_idx < num_segments_to_compare) && keep; seg_idx++)
+        {
+            keep = jsonTokenMatchesSegment(p_js_buffer, p_key_path[seg_idx], &p_path->segments[seg_idx]);
+        }
+    }
+
+    return (keep ? 1 : 0);
+}
+
+// Compares a key token to a path segment. The hash and length must match before the strings are compared.
+static bool jsonTokenMatchesSegment(const char *const p_js_buffer, const jsmntok_t *const p_tok,
+                                    const jsonPathSegment_t *const p_segment)
+{
+    return ((p_tok->hash == p_segment->hash) &&
+            ((p_tok->end - p_tok->start) == p_segment->len) &&
+            (memcmp(&p_js_buffer[p_tok->start], p_segment->str, p_segment->len) == 0));
+}
+
+
+
+// Finds a value's token index in the list, using the known parent and the value's key
 static int jsonFindKeyValueToken(const jsmnTokenizationData_t *const p_tok_data, const char *const p_json_buff,
-                                 const char *const key_str, const int key_str_len, const jsmntype_t type, const int parent_idx)
+                                 const jsonPathSegment_t *const p_segment, const jsmntype_t type, const int parent_idx)
 {
-    int idx = 0;
+    // Keys of the parent come after it, and before the token following it
+    int idx = (parent_idx + 1);
+    const int end_idx = (parent_idx < p_tok_data->num_tokens) ? jsonTokenSkip(p_tok_data, parent_idx) : 0;
     bool key_found = false;
-    while (idx < p_tok_data->num_tokens && !key_found)
+    while (idx < end_idx && !key_found)
     {
         // Parent object matches and the data is a string
         if (p_tok_data->p_tokens[idx].parent == parent_idx &&
             p_tok_data->p_tokens[idx].type == JSMN_STRING)
         {
-            const jsmntok_t *const p_key_tok = &p_tok_data->p_tokens[idx];
             // Check to see if key string matches to the JSON string data
-            // TODO: There should be a check to ensure that strncmp doesn't read outside the json buffer
-            if (strncmp(key_str, &p_json_buff[p_key_tok->start], key_str_len) == 0)
+            if (jsonTokenMatchesSegment(p_json_buff, &p_tok_data->p_tokens[idx], p_segment))
             {
                 // check to see the next token type matches the required type, if so, value is found
                 // otherwise keep going
-                key_found = (p_tok_data->p_tokens[idx + 1].type == type);
+                key_found = ((idx + 1) < p_tok_data->num_tokens) && (p_tok_data->p_tokens[idx + 1].type == type);
             }
         }
         ++idx;
@@ -225,20 +1397,22 @@ static int jsonFindKeyValueToken(const jsmnTokenizationData_t *const p_tok_data,
 static void jsonDeserializeEnum(const char *const p_token_str, const int token_len,
                                 void *const p_dest, const int dest_size,
                                 const enumLabel_t *const p_enum_labels,
+                                const enumLabelIndex_t *const p_enum_index,
                                 const char *const p_key_str)
 {
-    // For deserialization, the string data must fit in to the temporary buffer
-    // If this fails, increase the enum buffer size or reduce the size of the string
-    // that represents the enum value
-    assert(token_len < JSON_ENUM_STR_BUFF_SIZE - 1);
-    assert(p_enum_labels != NULL);
-    // Buffer must be initialized to 0 for string ops
-    char buff[JSON_ENUM_STR_BUFF_SIZE] = {0};
-    // Only every copy at a max the size of the buffer -1 (to keep the null term byte)
-    memcpy(buff, p_token_str, min(token_len, (JSON_ENUM_STR_BUFF_SIZE - 1)));
+    assert((p_enum_labels != NULL) || (p_enum_index != NULL));
 
+    // The label is matched straight out of the JSON data
     int value = 0;
-    bool enum_rslt = elGetValueFromString(p_enum_labels, buff, &value, false);
+    bool enum_rslt;
+    if (p_enum_index != NULL)
+    {
+        enum_rslt = elIndexGetValue(p_enum_index, p_token_str, token_len, &value, false);
+    }
+    else
+    {
+        enum_rslt = elGetValueFromBuffer(p_enum_labels, p_token_str, token_len, &value, false);
+    }
 
     if (!enum_rslt)
     {
@@ -246,8 +1420,8 @@ static void jsonDeserializeEnum(const char *const p_token_str, const int token_l
         // This will occur if the enum that is received does not match any of the data in the
         // list. It COULD be acceptable if a single JSON element is "shared" across two separate
         // sections. Then no one enum list will contain all of the possible enumerations.
-        JSON_TRACE_MSG("Unexpected value %s for enum %s. This may be acceptable.",
-                       buff, p_key_str);
+        JSON_TRACE_MSG("Unexpected value %.*s for enum %s. This may be acceptable.",
+                       token_len, p_token_str, p_key_str);
     }
 
     // Write value based on destination size
@@ -274,24 +1448,21 @@ static void jsonDeserializeEnum(const char *const p_token_str, const int token_l
 
 // Deserializes a JSON String into a C String buffer
 //
-// Takes a string (p_token_str) and length and writes the character data to the destination.
-// Destination will be null terminated based on null_term_dest.
+// Takes a string (p_token_str) and length and writes the decoded character data to the destination.
+// All parsed strings will be NULL terminated, and truncated if they do not fit.
 static void jsonDeserializeString(const char *const p_token_str, const int token_len,
                                   char *const p_dest, const int dest_len)
 {
-    strncpy_s(p_dest,dest_len, p_token_str, token_len);
+    const int copied_len = jsonStringCopy(p_token_str, token_len, p_dest, dest_len);
 
-    if (token_len > dest_len)
+    // Decoding never makes a string longer, so only tokens that are at least as long as the buffer can be cut.
+    // A decoded string that is cut leaves up to 3 bytes of the buffer unused (the UTF-8 character that did not fit).
+    if ((token_len >= dest_len) && (copied_len >= (dest_len - 4)) && (copied_len < token_len))
     {
-        // String was copied but truncated.
-        JSON_DEBUG_MSG("JSON document string value %.*s is %d bytes longer than the destination length of %d",
-                       token_len, p_token_str, (token_len - dest_len), dest_len);
+        // String was copied but (most likely) truncated.
+        JSON_DEBUG_MSG("JSON document string value %.*s does not fit in the destination length of %d",
+                       token_len, p_token_str, dest_len);
     }
-
-    // All parsed strings will be NULL terminated.
-    // Ensure either the position at end of the copied string or
-    // at the end of the buffer is a null character
-    p_dest[min(token_len, (dest_len - 1))] = '\0';
 }
 
 // Deserializes a JSON Primitive into a C Primitive data element (p_dest)
@@ -334,9 +1505,10 @@ static void jsonDeserializePrimitive(const char *const p_token_str, const int to
             break;
     }
 
-    // Casting the token pointer from a const char to a regular char pointer
-    // to avoid warnings when using the stdlib function calls with a const char pointer
-    char *p_token_str_end = (char *)(p_token_str + token_len);
+    // Values that do not fit in the destination are clamped to its range
+    bool number_valid = true;
+    int64_t int_value = 0;
+    uint64_t uint_value = 0;
 
     // Examine the first character to determine which function handles the deserialization
     switch (tolower(p_token_str[0]))
@@ -366,39 +1538,42 @@ static void jsonDeserializePrimitive(const char *const p_token_str, const int to
 
             if (c_type == E_JSON_C_INT8)
             {
-                // It is possible this will overflow, but it will be safe
-                *((int8_t *)p_dest) = (int8_t)strtol(p_token_str, &p_token_str_end, 10);
+                number_valid = jsonNumberParseInt(p_token_str, token_len, INT8_MIN, INT8_MAX, &int_value);
+                *((int8_t *)p_dest) = (int8_t)int_value;
             }
             else if (c_type == E_JSON_C_INT16)
             {
-                // It is possible this will overflow, but it will be safe
-                *((int16_t *)p_dest) = (int16_t)strtol(p_token_str, &p_token_str_end, 10);
+                number_valid = jsonNumberParseInt(p_token_str, token_len, INT16_MIN, INT16_MAX, &int_value);
+                *((int16_t *)p_dest) = (int16_t)int_value;
             }
             else if (c_type == E_JSON_C_INT32)
             {
-                *((int32_t *)p_dest) = strtol(p_token_str, &p_token_str_end, 10);
+                number_valid = jsonNumberParseInt(p_token_str, token_len, INT32_MIN, INT32_MAX, &int_value);
+                *((int32_t *)p_dest) = (int32_t)int_value;
             }
             else if (c_type == E_JSON_C_INT64)
             {
-                *((int64_t *)p_dest) = strtoll(p_token_str, &p_token_str_end, 10);
+                number_valid = jsonNumberParseInt(p_token_str, token_len, INT64_MIN, INT64_MAX, &int_value);
+                *((int64_t *)p_dest) = int_value;
             }
             else if (c_type == E_JSON_C_UINT8)
             {
-                // It is possible this will overflow, but it will be safe
-                *((uint8_t *)p_dest) = (uint8_t)strtoul(p_token_str, &p_token_str_end, 10);
+                number_valid = jsonNumberParseUint(p_token_str, token_len, UINT8_MAX, &uint_value);
+                *((uint8_t *)p_dest) = (uint8_t)uint_value;
             }
             else if (c_type == E_JSON_C_UINT16)
             {
-                // It is possible this will overflow, but it will be safe
-                *((uint16_t *)p_dest) = (uint16_t)strtoul(p_token_str, &p_token_str_end, 10);
+                number_valid = jsonNumberParseUint(p_token_str, token_len, UINT16_MAX, &uint_value);
+                *((uint16_t *)p_dest) = (uint16_t)uint_value;
             }
             else if (c_type == E_JSON_C_UINT32)
             {
-                *((uint32_t *)p_dest) = strtoul(p_token_str, &p_token_str_end, 10);
+                number_valid = jsonNumberParseUint(p_token_str, token_len, UINT32_MAX, &uint_value);
+                *((uint32_t *)p_dest) = (uint32_t)uint_value;
             }
             else if (c_type == E_JSON_C_FLOAT)
             {
-                *((float *)p_dest) = strtof(p_token_str, &p_token_str_end);
+                number_valid = jsonNumberParseFloat(p_token_str, token_len, (float *)p_dest);
             }
             else
             {
@@ -406,6 +1581,11 @@ static void jsonDeserializePrimitive(const char *const p_token_str, const int to
                 assert(false);
             }
 
+            if (!number_valid)
+            {
+                JSON_DEBUG_MSG("Number %.*s is out of range or not of the expected type\n", token_len, p_token_str);
+            }
+
             break;
 
         // Null
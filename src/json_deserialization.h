@@ -36,11 +36,28 @@
 /* ***************************    Includes     **************************** */
 
 #include "json_serialize_deserialize_types.h"
+#include "json_data_buffer.h"
+#include "json_string.h"
 
 /* ***************************   Definitions   **************************** */
 
-// Size in bytes of the temporary buffer used to do enum deserialization
-#define JSON_ENUM_STR_BUFF_SIZE         40
+// Maximum number of dot separated segments in a key path (i.e. "teams.home.team.name" is 4)
+#define JSON_MAX_PATH_SEGMENTS          12
+
+// Maximum number of key paths a path filter can hold
+#define JSON_PATH_FILTER_MAX_PATHS      16
+
+// Number of tokens a token arena allocates the first time it is used
+#define JSON_TOKEN_ARENA_DEFAULT_CAPACITY   2500
+
+// Maximum number of nodes in a path trie, one per distinct key path prefix (i.e. "teams", "teams.home", ...)
+#define JSON_PATH_TRIE_MAX_NODES        64
+
+// Maximum number of containers in a schema
+#define JSON_SCHEMA_MAX_NODES           8
+
+// Maximum number of steps in a path expression, every key, "[n]", "[*]" and "**" is a step
+#define JSON_PATH_EXPR_MAX_STEPS        16
 
 // Debug related macros, set to 1 to enable
 #define JSON_DEBUG_MSG_ENABLED        (1)
@@ -66,14 +83,164 @@ typedef struct
 {
     int num_tokens;      // Number of tokens in the dataset
     jsmntok_t *p_tokens; // Pointer to the tokens
+    jsonStringCache_t *p_string_cache; // Decoded string values, can be NULL to leave strings as they are
 } jsmnTokenizationData_t;
 
+// Token storage that is reused from one tokenization to the next. The storage only ever grows, so once it
+// has reached the size needed by the largest JSON data seen, tokenizing does not allocate anymore.
+// The storage comes from the buffer pool, and goes back to it when the arena is destroyed.
+typedef struct
+{
+    jsmntok_t *p_tokens;
+    int capacity;           // Number of tokens that fit in the storage
+    jsonDataBuffer_t token_buffer;
+    jsonStringCache_t strings; // Strings decoded out of the tokens, emptied by every tokenization
+
+    // Stats
+    int peak_tokens;        // Most tokens produced by a single tokenization
+    int num_reallocations;  // Number of times the storage had to be (re)allocated
+    int num_tokenizations;
+} jsonTokenArena_t;
+
+// A single key of a key path, with its hash precomputed so it can be compared to the hash of key tokens
+typedef struct
+{
+    const char *str;
+    int len;
+    unsigned int hash;
+} jsonPathSegment_t;
+
+// A key string split up on the '.' characters
+// NOTE: Segments point into the key string they were built from, that string must outlive the path
+typedef struct
+{
+    jsonPathSegment_t segments[JSON_MAX_PATH_SEGMENTS];
+    int num_segments;
+} jsonPath_t;
+
+// Set of key paths that are of interest to the tokenizer.
+// When attached to a parser, any value who's key path can not lead to one of the paths (and is
+// not inside one of them) is skipped without producing tokens.
+// Arrays are transparent to the filter, the elements of an array share the key path of the array.
+typedef struct
+{
+    jsonPath_t paths[JSON_PATH_FILTER_MAX_PATHS];
+    int num_paths;
+} jsonPathFilter_t;
+
+// Node of a path trie. The children of a node are linked through `next_sibling`.
+typedef struct
+{
+    jsonPathSegment_t segment; // Key leading from the parent node to this one
+    int first_child;           // Index of the first child node, -1 if there is none
+    int next_sibling;          // Index of the parent's next child node, -1 if there is none
+    int key_value_idx;         // Index in the key-value table of the value at this path, -1 if none ends here
+    int num_key_values;        // Number of key paths that end at this node or below it
+} jsonPathTrieNode_t;
+
+// Key-value table compiled into a trie of its key paths, with the object being deserialized as the root (node 0).
+// Paths that share a prefix share the nodes of that prefix, so every key of an object only has to be looked at once.
+// NOTE: The trie points into the key-value table, the table must outlive the trie
+typedef struct
+{
+    jsonPathTrieNode_t nodes[JSON_PATH_TRIE_MAX_NODES];
+    int num_nodes;
+    const jsonKeyValue_t *p_keys;
+    int num_keys;
+} jsonPathTrie_t;
+
+// Container of a schema, with what is needed to match it against the tokens
+typedef struct
+{
+    jsonContainer_t *p_container;
+    jsonPathSegment_t key;   // Key of the container in its parent object, length of 0 if it has none
+    jsonPathTrie_t key_trie; // Key list of an object container, no nodes if there is no key list
+    int first_child;         // Index of the node of the first child container, -1 if there is none
+    int next_sibling;        // Index of the node of the parent's next child container, -1 if there is none
+} jsonSchemaNode_t;
+
+// Tree of containers compiled for deserialization, the root container is node 0
+typedef struct
+{
+    jsonSchemaNode_t nodes[JSON_SCHEMA_MAX_NODES];
+    int num_nodes;
+} jsonSchema_t;
+
+// Kinds of steps in a path expression
+typedef enum
+{
+    E_JSON_PATH_STEP_KEY,       // Value of a key of an object
+    E_JSON_PATH_STEP_INDEX,     // "[n]", nth element of an array
+    E_JSON_PATH_STEP_ANY_INDEX, // "[*]", every element of an array
+    E_JSON_PATH_STEP_ANY_DEPTH, // "**", any number of keys and array elements, including none
+} jsonPathStepType_t;
+
+typedef struct
+{
+    jsonPathStepType_t type;
+    jsonPathSegment_t key; // E_JSON_PATH_STEP_KEY only
+    int index;             // E_JSON_PATH_STEP_INDEX only
+} jsonPathStep_t;
+
+// Path expression compiled by jsonPathExprInit(), i.e. "dates[*].games" or "**.team.name"
+// NOTE: Key steps point into the expression string they were built from, that string must outlive the expression
+typedef struct
+{
+    jsonPathStep_t steps[JSON_PATH_EXPR_MAX_STEPS];
+    int num_steps;
+} jsonPathExpr_t;
+
+// Called by jsonPathExprSearch() for every value matching the expression, in the order the values are in the
+// document. Returns false to stop the search.
+typedef bool (jsonPathMatchCbk_t)(void *p_ctx, const jsmnTokenizationData_t *const p_tok_data, const int tok_idx);
+
+// Keys of a key-value table that were not found in an object, see jsonCheckRequiredKeys()
+typedef struct
+{
+    int num_missing_required;
+    int num_missing_optional;
+    int first_missing_idx; // Index in the table of the first required key that is missing, -1 if there is none
+} jsonMissingKeys_t;
+
 /* ***********************   Function Prototypes   ************************ */
 
 int jsonSearchForElement(const jsmnTokenizationData_t *const p_tok_data, const char *const p_json_buff,
                          const jsonKeyValue_t *const p_key_val);
+bool jsonPathInit(jsonPath_t *const p_path, const char *const key_str);
+int jsonSearchForPath(const jsmnTokenizationData_t *const p_tok_data, const char *const p_json_buff,
+                      const jsonPath_t *const p_path, const jsmntype_t type);
+bool jsonPathExprInit(jsonPathExpr_t *const p_expr, const char *const expr_str);
+int jsonPathExprSearch(const jsonPathExpr_t *const p_expr, const jsmnTokenizationData_t *const p_tok_data,
+                       const char *const p_json_buff, const jsmntype_t type,
+                       jsonPathMatchCbk_t *const p_match_cbk, void *const p_cbk_ctx);
 void jsonDeserializeElement(const jsonKeyValue_t *const p_key_value,
                                    const jsmntok_t *const p_value_tok,
-                                   const char *const p_js_buffer, void *const p_data);
+                                   const char *const p_js_buffer, jsonStringCache_t *const p_string_cache,
+                                   void *const p_data);
+
+void jsonTokenArenaInit(jsonTokenArena_t *const p_arena);
+bool jsonTokenArenaTokenize(jsonTokenArena_t *const p_arena, const char *const p_json_buff, const size_t json_len,
+                            const jsonPathFilter_t *const p_filter, jsmnTokenizationData_t *const p_tok_data);
+void jsonTokenArenaDestroy(jsonTokenArena_t *const p_arena);
+
+bool jsonPathTrieInit(jsonPathTrie_t *const p_trie, const jsonKeyValue_t *const p_keys, const int num_keys);
+int jsonPathTrieDeserialize(const jsonPathTrie_t *const p_trie, const jsmnTokenizationData_t *const p_tok_data,
+                            const char *const p_json_buff, void *const p_data, bool *const p_found_keys);
+bool jsonCheckRequiredKeys(const jsonKeyValue_t *const p_keys, const int num_keys, const bool *const p_found_keys,
+                           jsonMissingKeys_t *const p_missing);
+
+bool jsonSchemaInit(jsonSchema_t *const p_schema, jsonContainer_t *const p_root);
+int jsonDeserializeSchema(const jsonSchema_t *const p_schema, const jsmnTokenizationData_t *const p_tok_data,
+                          const char *const p_json_buff);
+int jsonDeserializeArray(const jsonSchema_t *const p_element_schema, const jsmnTokenizationData_t *const p_tok_data,
+                         const char *const p_json_buff, const int array_tok_idx, void *const p_dest,
+                         const size_t stride, const int max_elements);
+int jsonDeserializeObject(const jsonSchema_t *const p_schema, const jsmnTokenizationData_t *const p_tok_data,
+                          const char *const p_json_buff, const int obj_tok_idx, void *const p_dest,
+                          bool *const p_found_keys);
+
+bool jsonPathFilterInit(jsonPathFilter_t *const p_filter, const char *const prefix_str,
+                        const jsonKeyValue_t *const p_keys, const int num_keys);
+void jsonPathFilterAttach(jsmn_parser *const p_parser, const jsonPathFilter_t *const p_filter);
 
 #endif /* JSON_DESERIALIZATION_H */
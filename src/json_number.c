@@ -0,0 +1,403 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  json_number.c
+//
+//  JSON Number Conversion
+//
+//  Module description in json_number.h
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+/* ***************************    Includes     **************************** */
+
+// Standard Includes
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Library Includes
+#include <SDL.h>
+
+// Project Includes
+#include "utility.h"
+
+// Module Includes
+#include "json_number.h"
+
+/* ***************************   Definitions   **************************** */
+
+// Largest value that 8 more digits can be added to without overflowing
+#define JSON_NUMBER_SWAR_MAX_VALUE      ((UINT64_MAX - 99999999u) / 100000000u)
+
+// Floats up to this value are exact, so are the powers of 10 up to JSON_NUMBER_FLOAT_MAX_POW10
+#define JSON_NUMBER_FLOAT_MAX_EXACT     (1u << 24)
+#define JSON_NUMBER_FLOAT_MAX_POW10     10
+
+// Same for doubles
+#define JSON_NUMBER_DOUBLE_MAX_EXACT    (1ull << 53)
+#define JSON_NUMBER_DOUBLE_MAX_POW10    22
+
+// Exponents past this are 0 or infinite no matter the digits, larger ones are not accumulated
+#define JSON_NUMBER_MAX_EXPONENT        100000
+
+/* ****************************   Structures   **************************** */
+
+// Digits of a number read so far
+typedef struct
+{
+    uint64_t value;         // Value of the digits that fit
+    int num_digits;         // Number of digits read, including those dropped
+    int num_dropped;        // Digits that did not fit in `value`, after the last one that did
+    bool nonzero_dropped;   // At least one of the dropped digits was not a 0, so `value` is not exact
+} jsonNumberDigits_t;
+
+/* ***********************   Function Prototypes   ************************ */
+
+static int jsonNumberReadDigits(const char *const p_str, const int len, int idx, jsonNumberDigits_t *const p_digits);
+static bool jsonNumberLoadEightDigits(const char *const p_str, uint64_t *const p_chunk);
+static uint32_t jsonNumberEightDigitsValue(uint64_t chunk);
+static double jsonNumberScale(const uint64_t mantissa, int exponent);
+
+/* ***********************   File Scope Variables   *********************** */
+
+static const float g_float_pow10[JSON_NUMBER_FLOAT_MAX_POW10 + 1] =
+    {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+static const double g_double_pow10[JSON_NUMBER_DOUBLE_MAX_POW10 + 1] =
+    {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/* ****************************   BEGIN CODE   **************************** */
+
+/* *************************   Public  Functions   ************************ */
+
+// Converts a signed integer. null, fractions and exponents are not valid integers.
+// min_value/max_value[in]: Range of the destination type, i.e. INT16_MIN/INT16_MAX
+bool jsonNumberParseInt(const char *const p_str, const int len, const int64_t min_value, const int64_t max_value,
+                        int64_t *const p_value)
+{
+    assert((min_value <= 0) && (max_value >= 0));
+
+    const bool negative = ((len > 0) && (p_str[0] == '-'));
+    jsonNumberDigits_t digits = {.value = 0, .num_digits = 0, .num_dropped = 0, .nonzero_dropped = false};
+    const int end_idx = jsonNumberReadDigits(p_str, len, (negative ? 1 : 0), &digits);
+    bool valid = ((digits.num_digits > 0) && (end_idx == len));
+
+    // Largest magnitude that fits, in the direction of the sign
+    const uint64_t limit = negative ? ((uint64_t)(-(min_value + 1)) + 1) : (uint64_t)max_value;
+    if ((digits.num_dropped > 0) || (digits.value > limit))
+    {
+        valid = false;
+        *p_value = negative ? min_value : max_value;
+    }
+    else if (negative && (digits.value > 0))
+    {
+        // Written so that the magnitude of INT64_MIN does not overflow
+        *p_value = -(int64_t)(digits.value - 1) - 1;
+    }
+    else
+    {
+        *p_value = (int64_t)digits.value;
+    }
+
+    return valid;
+}
+
+// Converts an unsigned integer. null, fractions, exponents and negative numbers are not valid.
+// max_value[in]: Largest value of the destination type, i.e. UINT16_MAX
+bool jsonNumberParseUint(const char *const p_str, const int len, const uint64_t max_value, uint64_t *const p_value)
+{
+    jsonNumberDigits_t digits = {.value = 0, .num_digits = 0, .num_dropped = 0, .nonzero_dropped = false};
+    const int end_idx = jsonNumberReadDigits(p_str, len, 0, &digits);
+    bool valid = ((digits.num_digits > 0) && (end_idx == len));
+
+    if ((digits.num_dropped > 0) || (digits.value > max_value))
+    {
+        valid = false;
+        *p_value = max_value;
+    }
+    else
+    {
+        *p_value = digits.value;
+    }
+
+    return valid;
+}
+
+// Converts a number with an optional fraction and exponent. null is not a valid number.
+// Numbers too large for a float are clamped to +/-FLT_MAX, and are not valid.
+bool jsonNumberParseFloat(const char *const p_str, const int len, float *const p_value)
+{
+    const bool negative = ((len > 0) && (p_str[0] == '-'));
+    jsonNumberDigits_t digits = {.value = 0, .num_digits = 0, .num_dropped = 0, .nonzero_dropped = false};
+
+    // Integer part. Digits that were dropped still count towards the magnitude.
+    int idx = jsonNumberReadDigits(p_str, len, (negative ? 1 : 0), &digits);
+    bool valid = (digits.num_digits > 0);
+    int exponent = digits.num_dropped;
+
+    // Fraction. Only the digits that were kept move the decimal point.
+    if ((idx < len) && (p_str[idx] == '.'))
+    {
+        const int num_digits_before = digits.num_digits;
+        const int num_dropped_before = digits.num_dropped;
+        idx = jsonNumberReadDigits(p_str, len, (idx + 1), &digits);
+
+        const int num_fraction_digits = (digits.num_digits - num_digits_before);
+        exponent -= (num_fraction_digits - (digits.num_dropped - num_dropped_before));
+        valid = valid && (num_fraction_digits > 0);
+    }
+
+    // Exponent
+    if ((idx < len) && ((p_str[idx] == 'e') || (p_str[idx] == 'E')))
+    {
+        idx++;
+        const bool negative_exponent = ((idx < len) && (p_str[idx] == '-'));
+        idx += ((idx < len) && ((p_str[idx] == '-') || (p_str[idx] == '+'))) ? 1 : 0;
+
+        int explicit_exponent = 0;
+        const int exponent_start_idx = idx;
+        while ((idx < len) && (p_str[idx] >= '0') && (p_str[idx] <= '9'))
+        {
+            explicit_exponent = min(((explicit_exponent * 10) + (p_str[idx] - '0')), JSON_NUMBER_MAX_EXPONENT);
+            idx++;
+        }
+
+        exponent += (negative_exponent ? -explicit_exponent : explicit_exponent);
+        valid = valid && (idx > exponent_start_idx);
+    }
+
+    valid = valid && (idx == len);
+
+    float value;
+    if (!digits.nonzero_dropped && (digits.value <= JSON_NUMBER_FLOAT_MAX_EXACT) &&
+        (exponent >= -JSON_NUMBER_FLOAT_MAX_POW10) && (exponent <= JSON_NUMBER_FLOAT_MAX_POW10))
+    {
+        // Both the digits and the power of 10 are exact, so the one rounding of the operation gives the exact result
+        value = (exponent < 0) ? ((float)digits.value / g_float_pow10[-exponent])
+                               : ((float)digits.value * g_float_pow10[exponent]);
+    }
+    else
+    {
+        value = (float)jsonNumberScale(digits.value, exponent);
+    }
+
+    if (isinf(value))
+    {
+        valid = false;
+        value = FLT_MAX;
+    }
+
+    *p_value = negative ? -value : value;
+    return valid;
+}
+
+#if (JSON_NUMBER_BENCHMARK_ENABLED == 1)
+// Times the conversions against the C library ones on a few samples of what shows up in the game data
+void jsonNumberBenchmark(void)
+{
+    static const char *const int_samples[] =
+        {"0", "7", "12", "-42", "2147483647", "-2147483648", "1528650300", "20180610"};
+    static const char *const float_samples[] =
+        {"0.5", "12.25", "-3.75", "0.333", "3.14159265", "-1.25e3", "6.02214076e23", "1e-7"};
+
+    // Token lengths are known when deserializing, so they are not part of the timing
+    int int_lens[ARRAY_SIZE(int_samples)];
+    int float_lens[ARRAY_SIZE(float_samples)];
+    for (uint32_t idx = 0; idx < ARRAY_SIZE(int_samples); idx++)
+    {
+        int_lens[idx] = (int)strlen(int_samples[idx]);
+    }
+    for (uint32_t idx = 0; idx < ARRAY_SIZE(float_samples); idx++)
+    {
+        float_lens[idx] = (int)strlen(float_samples[idx]);
+    }
+
+    const double counts_per_ns = ((double)SDL_GetPerformanceFrequency() / 1000000000.0);
+    const double num_int_conversions = ((double)JSON_NUMBER_BENCHMARK_ITERATIONS * ARRAY_SIZE(int_samples));
+    const double num_float_conversions = ((double)JSON_NUMBER_BENCHMARK_ITERATIONS * ARRAY_SIZE(float_samples));
+
+    // Sums of the results keep the conversions from being optimized away, and are compared between the two
+    int64_t int_sum = 0;
+    int64_t libc_int_sum = 0;
+    double float_sum = 0.0;
+    double libc_float_sum = 0.0;
+
+    Uint64 start_count = SDL_GetPerformanceCounter();
+    for (int iteration = 0; iteration < JSON_NUMBER_BENCHMARK_ITERATIONS; iteration++)
+    {
+        for (uint32_t idx = 0; idx < ARRAY_SIZE(int_samples); idx++)
+        {
+            int64_t value;
+            jsonNumberParseInt(int_samples[idx], int_lens[idx], INT64_MIN, INT64_MAX, &value);
+            int_sum += value;
+        }
+    }
+    Uint64 int_count = SDL_GetPerformanceCounter() - start_count;
+
+    start_count = SDL_GetPerformanceCounter();
+    for (int iteration = 0; iteration < JSON_NUMBER_BENCHMARK_ITERATIONS; iteration++)
+    {
+        for (uint32_t idx = 0; idx < ARRAY_SIZE(int_samples); idx++)
+        {
+            libc_int_sum += strtoll(int_samples[idx], NULL, 10);
+        }
+    }
+    Uint64 libc_int_count = SDL_GetPerformanceCounter() - start_count;
+
+    start_count = SDL_GetPerformanceCounter();
+    for (int iteration = 0; iteration < JSON_NUMBER_BENCHMARK_ITERATIONS; iteration++)
+    {
+        for (uint32_t idx = 0; idx < ARRAY_SIZE(float_samples); idx++)
+        {
+            float value;
+            jsonNumberParseFloat(float_samples[idx], float_lens[idx], &value);
+            float_sum += value;
+        }
+    }
+    Uint64 float_count = SDL_GetPerformanceCounter() - start_count;
+
+    start_count = SDL_GetPerformanceCounter();
+    for (int iteration = 0; iteration < JSON_NUMBER_BENCHMARK_ITERATIONS; iteration++)
+    {
+        for (uint32_t idx = 0; idx < ARRAY_SIZE(float_samples); idx++)
+        {
+            libc_float_sum += strtof(float_samples[idx], NULL);
+        }
+    }
+    Uint64 libc_float_count = SDL_GetPerformanceCounter() - start_count;
+
+    printf("Integers: %.1f ns, strtoll: %.1f ns per number (%s)\n",
+           ((double)int_count / counts_per_ns / num_int_conversions),
+           ((double)libc_int_count / counts_per_ns / num_int_conversions),
+           ((int_sum == libc_int_sum) ? "same results" : "DIFFERENT RESULTS"));
+    printf("Floats: %.1f ns, strtof: %.1f ns per number (%s)\n",
+           ((double)float_count / counts_per_ns / num_float_conversions),
+           ((double)libc_float_count / counts_per_ns / num_float_conversions),
+           ((float_sum == libc_float_sum) ? "same results" : "DIFFERENT RESULTS"));
+}
+#endif
+
+/* *************************   Private Functions   ************************ */
+
+// Reads a run of digits starting at idx, adding them to the digits read so far.
+// Returns the index of the first character that is not a digit.
+static int jsonNumberReadDigits(const char *const p_str, const int len, int idx, jsonNumberDigits_t *const p_digits)
+{
+    // 8 digits at a time, for as long as they fit
+    uint64_t chunk;
+    while (((len - idx) >= 8) && (p_digits->num_dropped == 0) && (p_digits->value <= JSON_NUMBER_SWAR_MAX_VALUE) &&
+           jsonNumberLoadEightDigits(&p_str[idx], &chunk))
+    {
+        p_digits->value = (p_digits->value * 100000000u) + jsonNumberEightDigitsValue(chunk);
+        p_digits->num_digits += 8;
+        idx += 8;
+    }
+
+    // Then one at a time. Once a digit does not fit, the ones after it are dropped too.
+    while ((idx < len) && (p_str[idx] >= '0') && (p_str[idx] <= '9'))
+    {
+        const uint32_t digit = (uint32_t)(p_str[idx] - '0');
+        if ((p_digits->num_dropped == 0) && (p_digits->value <= ((UINT64_MAX - digit) / 10)))
+        {
+            p_digits->value = (p_digits->value * 10) + digit;
+        }
+        else
+        {
+            p_digits->num_dropped++;
+            p_digits->nonzero_dropped = (p_digits->nonzero_dropped || (digit != 0));
+        }
+
+        p_digits->num_digits++;
+        idx++;
+    }
+
+    return idx;
+}
+
+// Loads 8 characters into a word, first character in the low byte (little endian, as on x86/x64 and ARM).
+// Returns true if all 8 are digits.
+static bool jsonNumberLoadEightDigits(const char *const p_str, uint64_t *const p_chunk)
+{
+    memcpy(p_chunk, p_str, sizeof(uint64_t));
+
+    // Digits are 0x30 to 0x39: the high nibble of each byte must be 3, and adding 6 must not carry into it
+    return ((((*p_chunk & 0xF0F0F0F0F0F0F0F0u) |
+              (((*p_chunk + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4)) == 0x3333333333333333u));
+}
+
+// Converts 8 digit characters loaded by jsonNumberLoadEightDigits() to their value.
+// Pairs of digits are combined, then pairs of pairs, then the two halves, with 3 multiplications in all.
+static uint32_t jsonNumberEightDigitsValue(uint64_t chunk)
+{
+    const uint64_t mask = 0x000000FF000000FFu;
+    const uint64_t mul1 = 0x000F424000000064u; // 100 + (1000000 << 32)
+    const uint64_t mul2 = 0x0000271000000001u; // 1 + (10000 << 32)
+
+    chunk -= 0x3030303030303030u;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+
+    return (uint32_t)chunk;
+}
+
+// Computes mantissa * 10^exponent in double precision. Exact when both the mantissa and the power of 10
+// are, otherwise within a few units in the last place, which is well below the precision of a float.
+static double jsonNumberScale(const uint64_t mantissa, int exponent)
+{
+    double value = (double)mantissa;
+    if ((mantissa <= JSON_NUMBER_DOUBLE_MAX_EXACT) &&
+        (exponent >= -JSON_NUMBER_DOUBLE_MAX_POW10) && (exponent <= JSON_NUMBER_DOUBLE_MAX_POW10))
+    {
+        value = (exponent < 0) ? (value / g_double_pow10[-exponent]) : (value * g_double_pow10[exponent]);
+    }
+    else
+    {
+        while ((exponent > JSON_NUMBER_DOUBLE_MAX_POW10) && !isinf(value) && (value != 0.0))
+        {
+            value *= g_double_pow10[JSON_NUMBER_DOUBLE_MAX_POW10];
+            exponent -= JSON_NUMBER_DOUBLE_MAX_POW10;
+        }
+
+        while ((exponent < -JSON_NUMBER_DOUBLE_MAX_POW10) && (value != 0.0))
+        {
+            value /= g_double_pow10[JSON_NUMBER_DOUBLE_MAX_POW10];
+            exponent += JSON_NUMBER_DOUBLE_MAX_POW10;
+        }
+
+        if ((exponent >= -JSON_NUMBER_DOUBLE_MAX_POW10) && (exponent <= JSON_NUMBER_DOUBLE_MAX_POW10))
+        {
+            value = (exponent < 0) ? (value / g_double_pow10[-exponent]) : (value * g_double_pow10[exponent]);
+        }
+    }
+
+    return value;
+}
@@ -0,0 +1,69 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  json_number.h
+//
+//  JSON Number Conversion
+//
+//  Converts the text of JSON number tokens into integers and floats. Unlike strtol()/strtof(),
+//  the conversions never read past the given length (tokens are not NULL terminated), do not depend
+//  on the locale, and report values that do not fit in the destination.
+//
+//  Runs of 8 digits are converted at once with SWAR arithmetic (all 8 digits in one 64 bit word).
+//  Floats with up to 7 significant digits and small exponents are converted exactly with a single
+//  multiplication or division (Clinger's fast path), anything else goes through double precision.
+//  The result is then the correctly rounded float, except for numbers that are within about 1e-16
+//  of halfway between two floats.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JSON_NUMBER_H
+#define JSON_NUMBER_H
+
+/* ***************************    Includes     **************************** */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ***************************   Definitions   **************************** */
+
+// When enabled, the conversions are timed against the C library ones on a set of sample numbers
+// by jsonNumberBenchmark(), and the results are printed
+#define JSON_NUMBER_BENCHMARK_ENABLED       (0)
+#define JSON_NUMBER_BENCHMARK_ITERATIONS    100000
+
+/* ***********************   Function Prototypes   ************************ */
+
+// The conversions below all return false if the text is not entirely a number, or if the number
+// does not fit in the range given. The value is still set to what could be converted, clamped to the range.
+bool jsonNumberParseInt(const char *const p_str, const int len, const int64_t min_value, const int64_t max_value,
+                        int64_t *const p_value);
+bool jsonNumberParseUint(const char *const p_str, const int len, const uint64_t max_value, uint64_t *const p_value);
+bool jsonNumberParseFloat(const char *const p_str, const int len, float *const p_value);
+
+#if (JSON_NUMBER_BENCHMARK_ENABLED == 1)
+void jsonNumberBenchmark(void);
+#endif
+
+#endif /* JSON_NUMBER_H */
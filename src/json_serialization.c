@@ -0,0 +1,765 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  json_serialization.c
+//
+//  JSON Serialization
+//
+//  Module description in json_serialization.h
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+/* ***************************    Includes     **************************** */
+
+// Standard Includes
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project Includes
+#include "utility.h"
+
+// Module Includes
+#include "json_serialization.h"
+
+/* ***************************   Definitions   **************************** */
+
+#define MODULE_NAME_DEBUG       "JSON_Ser"
+
+// Longest text of a number. 64 bit integers are up to 20 digits and a sign, floats are up to 9 significant
+// digits with a sign, a point, and a 2 digit exponent (or leading zeros).
+#define JSON_NUMBER_MAX_TEXT_LEN        24
+
+// Escaped characters take up to 6 bytes (\u00XX)
+#define JSON_ESCAPED_CHAR_MAX_LEN       6
+
+/* ***********************   Function Prototypes   ************************ */
+
+static bool jsonSerializerAddKey(jsonSerializer_t *const p_serializer, const jsonPathSegment_t *const p_segment,
+                                 jsonKeyText_t *const p_key);
+static void jsonSerializeContainer(const jsonSerializer_t *const p_serializer, const int node_idx,
+                                   const uint8_t *const p_data, const int element_idx, jsonWriteBuffer_t *const p_out);
+static void jsonSerializeObjectData(const jsonSerializer_t *const p_serializer, const int node_idx,
+                                    const uint8_t *const p_data, const bool *const p_selected,
+                                    jsonWriteBuffer_t *const p_out);
+static void jsonSerializeTrieChildren(const jsonSerializer_t *const p_serializer, const int node_idx,
+                                      const int trie_node_idx, const uint8_t *const p_data,
+                                      const bool *const p_selected, jsonWriteBuffer_t *const p_out,
+                                      bool *const p_first);
+static void jsonSerializeArrayData(const jsonSerializer_t *const p_serializer, const int node_idx,
+                                   const uint8_t *const p_data, jsonWriteBuffer_t *const p_out);
+static void jsonSerializeKeyValue(const jsonKeyValue_t *const p_key_value, const uint8_t *const p_data,
+                                  jsonWriteBuffer_t *const p_out);
+static void jsonSerializePrimitive(const uint8_t *const p_value, const int value_size,
+                                   const jsonCPrimitiveType_t c_type, jsonWriteBuffer_t *const p_out);
+static int jsonWriteFloat(char *const p_dest, const float value);
+static void jsonWriteKey(const jsonSerializer_t *const p_serializer, const jsonKeyText_t *const p_key,
+                         bool *const p_first, jsonWriteBuffer_t *const p_out);
+static void jsonWriteString(const char *const p_str, const int len, jsonWriteBuffer_t *const p_out);
+static void jsonWriteText(const char *const p_text, const size_t len, jsonWriteBuffer_t *const p_out);
+static bool jsonWriteBufferReserve(jsonWriteBuffer_t *const p_out, const size_t len);
+
+/* ***********************   File Scope Variables   *********************** */
+
+// "00" to "99", numbers are written two digits at a time
+static const char g_digit_pairs[200] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+// Escape of each byte in a string, 0 if it is written as it is. The character that follows the '\\', with
+// 'u' for the control characters that are written as \\u00XX.
+static const char g_string_escapes[256] =
+    {
+        'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u', // 0x00 - 0x0F
+        'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', // 0x10 - 0x1F
+        ['"'] = '"',
+        ['\\'] = '\\',
+};
+
+static const char g_hex_digits[] = "0123456789ABCDEF";
+
+/* ****************************   BEGIN CODE   **************************** */
+
+/* *************************   Public  Functions   ************************ */
+
+// Sets up an empty buffer, nothing is allocated until the first write
+void jsonWriteBufferInit(jsonWriteBuffer_t *const p_out)
+{
+    memset(p_out, 0, sizeof(jsonWriteBuffer_t));
+}
+
+// Empties the buffer, so it can be written again. The memory is kept.
+void jsonWriteBufferReset(jsonWriteBuffer_t *const p_out)
+{
+    p_out->len = 0;
+    p_out->overflowed = false;
+}
+
+void jsonWriteBufferDestroy(jsonWriteBuffer_t *const p_out)
+{
+    free(p_out->p_buffer);
+    memset(p_out, 0, sizeof(jsonWriteBuffer_t));
+}
+
+// Compiles a tree of containers for serialization. See jsonSchemaInit(), the same trees can be used for both.
+// Returns false if the tree does not fit in a schema, or its keys do not fit in the serializer.
+bool jsonSerializerInit(jsonSerializer_t *const p_serializer, jsonContainer_t *const p_root)
+{
+    memset(p_serializer, 0, sizeof(jsonSerializer_t));
+
+    bool fits = jsonSchemaInit(&p_serializer->schema, p_root);
+    for (int node_idx = 0; (node_idx < p_serializer->schema.num_nodes) && fits; node_idx++)
+    {
+        const jsonSchemaNode_t *const p_node = &p_serializer->schema.nodes[node_idx];
+        fits = jsonSerializerAddKey(p_serializer, &p_node->key, &p_serializer->container_keys[node_idx]);
+
+        // The root of a trie has no key
+        for (int trie_node_idx = 1; (trie_node_idx < p_node->key_trie.num_nodes) && fits; trie_node_idx++)
+        {
+            fits = jsonSerializerAddKey(p_serializer, &p_node->key_trie.nodes[trie_node_idx].segment,
+                                        &p_serializer->trie_keys[node_idx][trie_node_idx]);
+        }
+    }
+
+    if (!fits)
+    {
+        JSON_DEBUG_MSG("Container tree does not fit in a serializer\n");
+        p_serializer->schema.num_nodes = 0;
+    }
+
+    return fits;
+}
+
+// Appends the root container, and everything inside of it, to the buffer.
+// * Object containers write their key list (the keys selected by `p_elements_to_serialize`, or all of them) out
+//   of their `p_data`, followed by their child containers. Keys sharing a path prefix are nested in the same object.
+//   Objects that are elements of an array have one set of selected keys per element, one after the other.
+// * Array containers write `num_elements` elements out of their `p_data`, each `element_size` apart. Elements that
+//   are objects or arrays are described by the array's first child, the others by the array's own value types.
+// * Containers with a NULL `p_data` are written as null.
+// Returns false if the buffer could not be grown to hold all of the text.
+bool jsonSerialize(const jsonSerializer_t *const p_serializer, jsonWriteBuffer_t *const p_out)
+{
+    if (p_serializer->schema.num_nodes > 0)
+    {
+        jsonSerializeContainer(p_serializer, 0, (const uint8_t *)p_serializer->schema.nodes[0].p_container->p_data, 0,
+                               p_out);
+    }
+
+    return !p_out->overflowed;
+}
+
+// Appends a single object to the buffer, out of p_src instead of the root container's `p_data`
+// p_serializer[in]: Compiled from the E_JSON_OBJECT container that describes the object
+// Returns false if the buffer could not be grown to hold all of the text.
+bool jsonSerializeObject(const jsonSerializer_t *const p_serializer, const void *const p_src,
+                         jsonWriteBuffer_t *const p_out)
+{
+    if ((p_serializer->schema.num_nodes > 0) && (p_serializer->schema.nodes[0].p_container->type == E_JSON_OBJECT))
+    {
+        jsonSerializeContainer(p_serializer, 0, (const uint8_t *)p_src, 0, p_out);
+    }
+
+    return !p_out->overflowed;
+}
+
+// Appends an array of objects to the buffer, the reverse of jsonDeserializeArray()
+// p_element_serializer[in]: Compiled from the E_JSON_OBJECT container that describes an element
+// p_src[in]: First element
+// stride: Number of bytes from one element to the next
+// NOTE: Like `p_deserialized_elements`, the container's `p_elements_to_serialize` holds one set of keys per element
+// Returns false if the buffer could not be grown to hold all of the text.
+bool jsonSerializeArray(const jsonSerializer_t *const p_element_serializer, const void *const p_src,
+                        const size_t stride, const int num_elements, jsonWriteBuffer_t *const p_out)
+{
+    const bool is_object = (p_element_serializer->schema.num_nodes > 0) &&
+                           (p_element_serializer->schema.nodes[0].p_container->type == E_JSON_OBJECT);
+
+    jsonWriteText("[", 1, p_out);
+    for (int idx = 0; (idx < num_elements) && is_object; idx++)
+    {
+        if (idx > 0)
+        {
+            jsonWriteText(",", 1, p_out);
+        }
+        jsonSerializeContainer(p_element_serializer, 0, ((const uint8_t *)p_src + (idx * stride)), idx, p_out);
+    }
+    jsonWriteText("]", 1, p_out);
+
+    return !p_out->overflowed;
+}
+
+// Writes the digits of an integer, two at a time, and returns the number of characters written (1 to 20).
+// The text is not NULL terminated.
+int jsonWriteUint64(char *const p_dest, uint64_t value)
+{
+    // Digits are found from the last one, so they are put together at the end of a scratch buffer
+    char digits[20];
+    int digit_idx = (int)sizeof(digits);
+    while (value >= 100)
+    {
+        const int pair_idx = (int)(value % 100) * 2;
+        value /= 100;
+        digit_idx -= 2;
+        digits[digit_idx] = g_digit_pairs[pair_idx];
+        digits[digit_idx + 1] = g_digit_pairs[pair_idx + 1];
+    }
+
+    if (value >= 10)
+    {
+        const int pair_idx = (int)value * 2;
+        digit_idx -= 2;
+        digits[digit_idx] = g_digit_pairs[pair_idx];
+        digits[digit_idx + 1] = g_digit_pairs[pair_idx + 1];
+    }
+    else
+    {
+        digits[--digit_idx] = (char)('0' + value);
+    }
+
+    const int len = ((int)sizeof(digits) - digit_idx);
+    memcpy(p_dest, &digits[digit_idx], len);
+    return len;
+}
+
+// Same as jsonWriteUint64(), with a '-' for negative values (1 to 20 characters)
+int jsonWriteInt64(char *const p_dest, const int64_t value)
+{
+    int len = 0;
+    uint64_t magnitude = (uint64_t)value;
+    if (value < 0)
+    {
+        p_dest[len++] = '-';
+        magnitude = (0 - magnitude);
+    }
+
+    return (len + jsonWriteUint64(&p_dest[len], magnitude));
+}
+
+/* *************************   Private Functions   ************************ */
+
+// Prepares the text written ahead of a key's value, `,"key":`. The ',' is left out for the first key of an object.
+// Segments without a key (i.e. unnamed containers) get no text.
+// Returns false if the text does not fit in the serializer.
+static bool jsonSerializerAddKey(jsonSerializer_t *const p_serializer, const jsonPathSegment_t *const p_segment,
+                                 jsonKeyText_t *const p_key)
+{
+    const int text_len = (p_segment->len + 4);
+    const bool fits = (p_segment->len == 0) ||
+                      ((p_serializer->key_text_len + text_len) <= JSON_SERIALIZER_MAX_KEY_BYTES);
+
+    if (fits && (p_segment->len > 0))
+    {
+        // Keys come from the key tables and containers, they are never escaped
+        assert((memchr(p_segment->str, '"', p_segment->len) == NULL) &&
+               (memchr(p_segment->str, '\\', p_segment->len) == NULL));
+
+        char *const p_text = &p_serializer->key_text[p_serializer->key_text_len];
+        p_text[0] = ',';
+        p_text[1] = '"';
+        memcpy(&p_text[2], p_segment->str, p_segment->len);
+        p_text[p_segment->len + 2] = '"';
+        p_text[p_segment->len + 3] = ':';
+
+        p_key->offset = (uint16_t)p_serializer->key_text_len;
+        p_key->len = (uint16_t)text_len;
+        p_serializer->key_text_len += text_len;
+    }
+
+    return fits;
+}
+
+// Writes a container and everything inside of it, out of p_data
+// element_idx: Position of the container in its array, 0 if it is not an element of an array
+static void jsonSerializeContainer(const jsonSerializer_t *const p_serializer, const int node_idx,
+                                   const uint8_t *const p_data, const int element_idx, jsonWriteBuffer_t *const p_out)
+{
+    const jsonContainer_t *const p_container = p_serializer->schema.nodes[node_idx].p_container;
+
+    if (p_data == NULL)
+    {
+        jsonWriteText("null", 4, p_out);
+    }
+    else if (p_container->type == E_JSON_OBJECT)
+    {
+        // Keys selected for this element, NULL to write all of them
+        const bool *const p_selected = (p_container->p_elements_to_serialize != NULL) ?
+                                       &p_container->p_elements_to_serialize[element_idx * p_container->p_key_list->size] :
+                                       NULL;
+        jsonSerializeObjectData(p_serializer, node_idx, p_data, p_selected, p_out);
+    }
+    else
+    {
+        jsonSerializeArrayData(p_serializer, node_idx, p_data, p_out);
+    }
+}
+
+// Writes an object: the values of its key list, then its child containers, which are written out of their own
+// `p_data`. Child containers without a key can't be part of an object and are left out.
+static void jsonSerializeObjectData(const jsonSerializer_t *const p_serializer, const int node_idx,
+                                    const uint8_t *const p_data, const bool *const p_selected,
+                                    jsonWriteBuffer_t *const p_out)
+{
+    const jsonSchemaNode_t *const p_node = &p_serializer->schema.nodes[node_idx];
+    bool first = true;
+
+    jsonWriteText("{", 1, p_out);
+    if (p_node->key_trie.num_nodes > 0)
+    {
+        jsonSerializeTrieChildren(p_serializer, node_idx, 0, p_data, p_selected, p_out, &first);
+    }
+
+    for (int child_idx = p_node->first_child; child_idx != -1; child_idx = p_serializer->schema.nodes[child_idx].next_sibling)
+    {
+        if (p_serializer->container_keys[child_idx].len > 0)
+        {
+            jsonWriteKey(p_serializer, &p_serializer->container_keys[child_idx], &first, p_out);
+            jsonSerializeContainer(p_serializer, child_idx,
+                                   (const uint8_t *)p_serializer->schema.nodes[child_idx].p_container->p_data, 0,
+                                   p_out);
+        }
+    }
+    jsonWriteText("}", 1, p_out);
+}
+
+// Writes the members found under a node of an object's key trie: the values at the end of a key path, and
+// nested objects for the keys in-between. Nested objects with none of their keys selected are left out.
+// p_selected[in]: Keys to be written, NULL for all of them
+// p_first[in/out]: Whether nothing has been written in the enclosing object yet
+static void jsonSerializeTrieChildren(const jsonSerializer_t *const p_serializer, const int node_idx,
+                                      const int trie_node_idx, const uint8_t *const p_data,
+                                      const bool *const p_selected, jsonWriteBuffer_t *const p_out,
+                                      bool *const p_first)
+{
+    const jsonPathTrie_t *const p_trie = &p_serializer->schema.nodes[node_idx].key_trie;
+
+    for (int child_idx = p_trie->nodes[trie_node_idx].first_child; child_idx != -1;
+         child_idx = p_trie->nodes[child_idx].next_sibling)
+    {
+        const jsonPathTrieNode_t *const p_child = &p_trie->nodes[child_idx];
+        const jsonKeyText_t *const p_key = &p_serializer->trie_keys[node_idx][child_idx];
+
+        if (p_child->key_value_idx != -1)
+        {
+            if ((p_selected == NULL) || p_selected[p_child->key_value_idx])
+            {
+                jsonWriteKey(p_serializer, p_key, p_first, p_out);
+                jsonSerializeKeyValue(&p_trie->p_keys[p_child->key_value_idx], p_data, p_out);
+            }
+        }
+        else
+        {
+            const size_t start_len = p_out->len;
+            const bool was_first = *p_first;
+            bool nested_first = true;
+
+            jsonWriteKey(p_serializer, p_key, p_first, p_out);
+            jsonWriteText("{", 1, p_out);
+            jsonSerializeTrieChildren(p_serializer, node_idx, child_idx, p_data, p_selected, p_out, &nested_first);
+
+            if (nested_first)
+            {
+                // Nothing in it, take the key back out
+                p_out->len = min(start_len, p_out->len);
+                *p_first = was_first;
+            }
+            else
+            {
+                jsonWriteText("}", 1, p_out);
+            }
+        }
+    }
+}
+
+// Writes the `num_elements` elements of an array
+static void jsonSerializeArrayData(const jsonSerializer_t *const p_serializer, const int node_idx,
+                                   const uint8_t *const p_data, jsonWriteBuffer_t *const p_out)
+{
+    const jsonSchemaNode_t *const p_node = &p_serializer->schema.nodes[node_idx];
+    const jsonContainer_t *const p_container = p_node->p_container;
+
+    // Arrays of strings and primitives, each element is a "member" at offset 0
+    const jsonKeyValue_t element_key_value =
+        {
+            .key_str = p_container->key_str,
+            .struct_member_offset = 0,
+            .struct_member_size = p_container->element_size,
+            .value_tok_type = p_container->value_tok_type,
+            .c_type = p_container->c_type,
+            .enum_labels = p_container->enum_labels,
+            .enum_index = p_container->enum_index,
+        };
+
+    // Nothing is stored for arrays without an element size
+    const int num_elements = ((p_container->element_size > 0) ? p_container->num_elements : 0);
+
+    jsonWriteText("[", 1, p_out);
+    for (int idx = 0; idx < num_elements; idx++)
+    {
+        const uint8_t *const p_element = (p_data + ((size_t)idx * p_container->element_size));
+        if (idx > 0)
+        {
+            jsonWriteText(",", 1, p_out);
+        }
+
+        if (p_node->first_child != -1)
+        {
+            // Containers in arrays are described by the first child
+            jsonSerializeContainer(p_serializer, p_node->first_child, p_element, idx, p_out);
+        }
+        else
+        {
+            jsonSerializeKeyValue(&element_key_value, p_element, p_out);
+        }
+    }
+    jsonWriteText("]", 1, p_out);
+}
+
+// Writes the value of a key-value table entry, the reverse of jsonDeserializeElement()
+static void jsonSerializeKeyValue(const jsonKeyValue_t *const p_key_value, const uint8_t *const p_data,
+                                  jsonWriteBuffer_t *const p_out)
+{
+    const uint8_t *const p_value = (p_data + p_key_value->struct_member_offset);
+
+    if ((p_key_value->value_tok_type == JSMN_STRING) && (p_key_value->c_type == E_JSON_C_ENUM))
+    {
+        // Enums are stored in 1, 2 or 4 bytes, like they are deserialized
+        int value = 0;
+        switch (p_key_value->struct_member_size)
+        {
+            case 1:
+                value = *((const uint8_t *)p_value);
+                break;
+
+            case 2:
+                value = *((const uint16_t *)p_value);
+                break;
+
+            case 4:
+                value = (int)*((const uint32_t *)p_value);
+                break;
+
+            default:
+                // Size of enum not supported
+                assert(false);
+                break;
+        }
+
+        const char *const p_label = (p_key_value->enum_index != NULL) ? elIndexGetLabel(p_key_value->enum_index, value) :
+                                                                         elGetLabel(p_key_value->enum_labels, value);
+        if (p_label != NULL)
+        {
+            jsonWriteString(p_label, (int)strlen(p_label), p_out);
+        }
+        else
+        {
+            jsonWriteText("null", 4, p_out);
+        }
+    }
+    else if ((p_key_value->value_tok_type == JSMN_STRING) && (p_key_value->c_type == E_JSON_C_STR_PTR))
+    {
+        // Strings that were never deserialized (i.e. an optional key that was missing) have no text
+        const jsonStr_t *const p_str = (const jsonStr_t *)p_value;
+        if (p_str->str != NULL)
+        {
+            jsonWriteString(p_str->str, p_str->len, p_out);
+        }
+        else
+        {
+            jsonWriteText("null", 4, p_out);
+        }
+    }
+    else if (p_key_value->value_tok_type == JSMN_STRING)
+    {
+        // String buffer, NULL terminated unless the string takes up all of it
+        const char *const p_end = memchr(p_value, '\0', p_key_value->struct_member_size);
+        const int len = (p_end != NULL) ? (int)(p_end - (const char *)p_value) : p_key_value->struct_member_size;
+        jsonWriteString((const char *)p_value, len, p_out);
+    }
+    else if (p_key_value->value_tok_type == JSMN_PRIMITIVE)
+    {
+        jsonSerializePrimitive(p_value, p_key_value->struct_member_size, p_key_value->c_type, p_out);
+    }
+    else
+    {
+        // Unsupported serialization of token type
+        assert(false);
+        jsonWriteText("null", 4, p_out);
+    }
+}
+
+// Writes a number or a boolean
+static void jsonSerializePrimitive(const uint8_t *const p_value, const int value_size,
+                                   const jsonCPrimitiveType_t c_type, jsonWriteBuffer_t *const p_out)
+{
+    if (jsonWriteBufferReserve(p_out, JSON_NUMBER_MAX_TEXT_LEN))
+    {
+        char *const p_dest = &p_out->p_buffer[p_out->len];
+        int len = 0;
+        switch (c_type)
+        {
+            case E_JSON_C_BOOL:
+                assert(value_size == (int)sizeof(bool));
+                len = *((const bool *)p_value) ? 4 : 5;
+                memcpy(p_dest, (*((const bool *)p_value) ? "true" : "false"), len);
+                break;
+
+            case E_JSON_C_INT8:
+                len = jsonWriteInt64(p_dest, *((const int8_t *)p_value));
+                break;
+
+            case E_JSON_C_INT16:
+                len = jsonWriteInt64(p_dest, *((const int16_t *)p_value));
+                break;
+
+            case E_JSON_C_INT32:
+                len = jsonWriteInt64(p_dest, *((const int32_t *)p_value));
+                break;
+
+            case E_JSON_C_INT64:
+                len = jsonWriteInt64(p_dest, *((const int64_t *)p_value));
+                break;
+
+            case E_JSON_C_UINT8:
+                len = jsonWriteUint64(p_dest, *((const uint8_t *)p_value));
+                break;
+
+            case E_JSON_C_UINT16:
+                len = jsonWriteUint64(p_dest, *((const uint16_t *)p_value));
+                break;
+
+            case E_JSON_C_UINT32:
+                len = jsonWriteUint64(p_dest, *((const uint32_t *)p_value));
+                break;
+
+            case E_JSON_C_FLOAT:
+                len = jsonWriteFloat(p_dest, *((const float *)p_value));
+                break;
+
+            default:
+                // Unsupported type
+                assert(false);
+                len = 4;
+                memcpy(p_dest, "null", len);
+                break;
+        }
+        p_out->len += len;
+    }
+}
+
+// Writes a float with up to 9 significant digits, which is enough to read back the same float. Whole numbers are
+// written without a fraction, very large and very small numbers with an exponent. NaN and infinities have no JSON
+// representation and are written as null.
+// Returns the number of characters written, at most JSON_NUMBER_MAX_TEXT_LEN.
+static int jsonWriteFloat(char *const p_dest, const float value)
+{
+    const double abs_value = fabs((double)value);
+    int len = 0;
+
+    if (!isfinite(value))
+    {
+        len = 4;
+        memcpy(p_dest, "null", len);
+    }
+    else if ((abs_value < 1e15) && (abs_value == floor(abs_value)))
+    {
+        len = jsonWriteInt64(p_dest, (int64_t)value);
+    }
+    else
+    {
+        // 9 digit mantissa, value = mantissa * 10^(exponent - 8)
+        int exponent = (int)floor(log10(abs_value));
+        double scaled = (abs_value / pow(10.0, (double)(exponent - 8)));
+        if (scaled < 99999999.5)
+        {
+            // log10() came out just above a power of 10
+            exponent--;
+            scaled *= 10.0;
+        }
+
+        uint64_t mantissa = (uint64_t)(scaled + 0.5);
+        if (mantissa >= 1000000000u)
+        {
+            // Rounding carried into a 10th digit
+            mantissa = ((mantissa + 5) / 10);
+            exponent++;
+        }
+
+        // Trailing zeros of the fraction are left out
+        int num_digits = 9;
+        while ((num_digits > 1) && ((mantissa % 10) == 0))
+        {
+            mantissa /= 10;
+            num_digits--;
+        }
+        char digits[20];
+        jsonWriteUint64(digits, mantissa);
+
+        if (value < 0.0f)
+        {
+            p_dest[len++] = '-';
+        }
+
+        if ((exponent >= 0) && (exponent < 9))
+        {
+            // ddd.ddd
+            const int num_int_digits = (exponent + 1);
+            for (int idx = 0; idx < num_int_digits; idx++)
+            {
+                p_dest[len++] = ((idx < num_digits) ? digits[idx] : '0');
+            }
+            if (num_digits > num_int_digits)
+            {
+                p_dest[len++] = '.';
+                memcpy(&p_dest[len], &digits[num_int_digits], (num_digits - num_int_digits));
+                len += (num_digits - num_int_digits);
+            }
+        }
+        else if ((exponent < 0) && (exponent >= -4))
+        {
+            // 0.000ddd
+            p_dest[len++] = '0';
+            p_dest[len++] = '.';
+            for (int idx = -1; idx > exponent; idx--)
+            {
+                p_dest[len++] = '0';
+            }
+            memcpy(&p_dest[len], digits, num_digits);
+            len += num_digits;
+        }
+        else
+        {
+            // d.ddde-XX
+            p_dest[len++] = digits[0];
+            if (num_digits > 1)
+            {
+                p_dest[len++] = '.';
+                memcpy(&p_dest[len], &digits[1], (num_digits - 1));
+                len += (num_digits - 1);
+            }
+            p_dest[len++] = 'e';
+            len += jsonWriteInt64(&p_dest[len], exponent);
+        }
+    }
+
+    return len;
+}
+
+// Writes the text ahead of a value, `"key":` for the first member of an object and `,"key":` for the others
+static void jsonWriteKey(const jsonSerializer_t *const p_serializer, const jsonKeyText_t *const p_key,
+                         bool *const p_first, jsonWriteBuffer_t *const p_out)
+{
+    const int skip = (*p_first ? 1 : 0);
+    jsonWriteText(&p_serializer->key_text[p_key->offset + skip], (size_t)(p_key->len - skip), p_out);
+    *p_first = false;
+}
+
+// Writes a string between quotes. Runs of characters that need no escaping are copied as they are,
+// UTF-8 included.
+static void jsonWriteString(const char *const p_str, const int len, jsonWriteBuffer_t *const p_out)
+{
+    // Room for every character to be escaped, so nothing has to be checked while copying
+    if (jsonWriteBufferReserve(p_out, (((size_t)len * JSON_ESCAPED_CHAR_MAX_LEN) + 2)))
+    {
+        char *const p_dest = &p_out->p_buffer[p_out->len];
+        int dest_idx = 0;
+        int run_start = 0;
+
+        p_dest[dest_idx++] = '"';
+        for (int idx = 0; idx < len; idx++)
+        {
+            const uint8_t str_char = (uint8_t)p_str[idx];
+            const char escape = g_string_escapes[str_char];
+            if (escape != 0)
+            {
+                memcpy(&p_dest[dest_idx], &p_str[run_start], (idx - run_start));
+                dest_idx += (idx - run_start);
+                run_start = (idx + 1);
+
+                p_dest[dest_idx++] = '\\';
+                p_dest[dest_idx++] = escape;
+                if (escape == 'u')
+                {
+                    p_dest[dest_idx++] = '0';
+                    p_dest[dest_idx++] = '0';
+                    p_dest[dest_idx++] = g_hex_digits[str_char >> 4];
+                    p_dest[dest_idx++] = g_hex_digits[str_char & 0x0F];
+                }
+            }
+        }
+        memcpy(&p_dest[dest_idx], &p_str[run_start], (len - run_start));
+        dest_idx += (len - run_start);
+        p_dest[dest_idx++] = '"';
+
+        p_out->len += dest_idx;
+    }
+}
+
+// Writes text as it is
+static void jsonWriteText(const char *const p_text, const size_t len, jsonWriteBuffer_t *const p_out)
+{
+    if (jsonWriteBufferReserve(p_out, len))
+    {
+        memcpy(&p_out->p_buffer[p_out->len], p_text, len);
+        p_out->len += len;
+    }
+}
+
+// Makes sure there is room for len more bytes, doubling the buffer as many times as needed.
+// Returns false if there is no room, the buffer is then marked as overflowed and nothing more is written to it.
+static bool jsonWriteBufferReserve(jsonWriteBuffer_t *const p_out, const size_t len)
+{
+    bool has_room = !p_out->overflowed && ((p_out->len + len) <= p_out->capacity);
+    if (!has_room && !p_out->overflowed)
+    {
+        size_t new_capacity = (p_out->capacity > 0) ? p_out->capacity : JSON_WRITE_BUFFER_DEFAULT_SIZE;
+        while (new_capacity < (p_out->len + len))
+        {
+            new_capacity *= 2;
+        }
+
+        char *const p_new_buffer = realloc(p_out->p_buffer, new_capacity);
+        if (p_new_buffer != NULL)
+        {
+            p_out->p_buffer = p_new_buffer;
+            p_out->capacity = new_capacity;
+            has_room = true;
+        }
+        else
+        {
+            JSON_DEBUG_MSG("Unable to grow the output buffer to %zu bytes\n", new_capacity);
+            p_out->overflowed = true;
+        }
+    }
+
+    return has_room;
+}
@@ -0,0 +1,107 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  json_serialization.h
+//
+//  JSON Serialization
+//
+//  Writes the data described by a tree of containers (jsonContainer_t) back out as JSON text, the
+//  reverse of jsonDeserializeSchema(). The tree is compiled once, like it is for deserialization: key
+//  lists become path tries, so dot notation keys that share a prefix are written as nested objects
+//  (i.e. "teams.home.score" and "teams.away.score" share the "teams" object), and the text written
+//  ahead of every value (`,"key":`) is prepared up front, so each key is a single copy.
+//
+//  Numbers are converted two digits at a time out of a table, strings are copied in runs between the
+//  characters that have to be escaped, and the output goes into a buffer that grows as needed and is
+//  reused from one call to the next.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JSON_SERIALIZATION_H
+#define JSON_SERIALIZATION_H
+
+/* ***************************    Includes     **************************** */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "json_serialize_deserialize_types.h"
+#include "json_deserialization.h"
+
+/* ***************************   Definitions   **************************** */
+
+// Size of the output buffer the first time it is written to, it doubles whenever it is full
+#define JSON_WRITE_BUFFER_DEFAULT_SIZE      4096
+
+// Bytes of key text a serializer can hold, `,"key":` for every container and key path segment
+#define JSON_SERIALIZER_MAX_KEY_BYTES       2048
+
+/* ****************************   Structures   **************************** */
+
+// Text written by the serializer. Grows as needed, the memory is kept from one use to the next.
+typedef struct
+{
+    char *p_buffer;
+    size_t len;      // Bytes written, the text is not NULL terminated
+    size_t capacity;
+    bool overflowed; // Set if the buffer could not be grown, the text is then incomplete. Cleared by a reset.
+} jsonWriteBuffer_t;
+
+// Location of the text of a key in the serializer, see jsonSerializer_t
+typedef struct
+{
+    uint16_t offset;
+    uint16_t len; // 0 for nodes without a key
+} jsonKeyText_t;
+
+// Tree of containers compiled for serialization, see jsonSerializerInit()
+// NOTE: The serializer points to the containers, which must outlive it. The containers' `p_data`,
+// NOTE: `num_elements` and `p_elements_to_serialize` can still be changed after compiling.
+typedef struct
+{
+    jsonSchema_t schema;
+    jsonKeyText_t container_keys[JSON_SCHEMA_MAX_NODES];                  // Key of each container in its parent
+    jsonKeyText_t trie_keys[JSON_SCHEMA_MAX_NODES][JSON_PATH_TRIE_MAX_NODES]; // Key of each node of the key tries
+    char key_text[JSON_SERIALIZER_MAX_KEY_BYTES];                         // `,"key":` of every key, one after the other
+    int key_text_len;
+} jsonSerializer_t;
+
+/* ***********************   Function Prototypes   ************************ */
+
+void jsonWriteBufferInit(jsonWriteBuffer_t *const p_out);
+void jsonWriteBufferReset(jsonWriteBuffer_t *const p_out);
+void jsonWriteBufferDestroy(jsonWriteBuffer_t *const p_out);
+
+bool jsonSerializerInit(jsonSerializer_t *const p_serializer, jsonContainer_t *const p_root);
+bool jsonSerialize(const jsonSerializer_t *const p_serializer, jsonWriteBuffer_t *const p_out);
+bool jsonSerializeObject(const jsonSerializer_t *const p_serializer, const void *const p_src,
+                         jsonWriteBuffer_t *const p_out);
+bool jsonSerializeArray(const jsonSerializer_t *const p_element_serializer, const void *const p_src,
+                        const size_t stride, const int num_elements, jsonWriteBuffer_t *const p_out);
+
+int jsonWriteUint64(char *const p_dest, uint64_t value);
+int jsonWriteInt64(char *const p_dest, const int64_t value);
+
+#endif /* JSON_SERIALIZATION_H */
@@ -134,12 +134,17 @@ typedef struct
     const int struct_member_offset; // Offset of the struct member to be deserialized to
     const int struct_member_size; // Size of the element of the struct (primarily used for string buffers)
     const jsmntype_t value_tok_type; // The JSMN token type that the value will be
+    // Value may be missing from the JSON data (i.e. a recap that is only written once the game is over).
+    // Every other key is required, see jsonCheckRequiredKeys().
+    const bool optional;
 
     // Below is meta data that may be populated based on the type of information represented
     // The primitive data type that the value string will be converted to
     const jsonCPrimitiveType_t c_type;
     // Table to translate string to an enum
     const enumLabel_t *const enum_labels;
+    // Optional, `enum_labels` compiled with elIndexInit(). Used instead of the table when set.
+    const enumLabelIndex_t *const enum_index;
 } jsonKeyValue_t;
 
 // Struct that contains the definition data around a array of jsonKeyValue_t data elements
@@ -149,6 +154,18 @@ typedef struct
     const int size; // Number of keys in the list
 } jsonKeyValueList_t;
 
+// Declared in json_string.h
+struct JsonStringCache;
+
+// Deserializes the object at token obj_tok_idx straight into the structure at p_data
+// p_string_cache[in]: Optional. Decodes the strings that have escapes or non-ASCII characters.
+// p_found_keys[out]: Optional. Set to true for every key of the object's key list that was found.
+// p_num_found[in/out]: Incremented for every key deserialized
+// Returns the index of the token following the object (and everything inside of it).
+typedef int (jsonObjectDeserializer_t)(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,
+                                       const char *const p_json_buff, struct JsonStringCache *const p_string_cache,
+                                       void *const p_data, bool *const p_found_keys, int *const p_num_found);
+
 // Type that defines JSON Objects
 // These contain lists of key/value pairs and can reference child objects
 typedef struct JsonContainer
@@ -188,15 +205,23 @@ typedef struct JsonContainer
             /////////////////////////////////////////////////////////////////////////////////////
 
             // Pointer to boolean array that will be written to when the keys are found in the JSON data.
+            // For the elements of an array, there is one set of keys per element, one after the other.
             // NOTE: OPTIONAL - Can be set to NULL if the feedback is not needed.
             // WARNING! MUST BE AT LEAST AS LARGE AS THE NUMBER OF KEYS IN THE LIST. (p_key_list->size)
+            // WARNING! FOR ARRAY ELEMENTS, (p_key_list->size * num_elements) OF THE ARRAY.
             bool *p_deserialized_elements;
 
             // Indicates to the serializer the specific data to serialize
             // Allows for a subset of the pointed-to key-value list to be serialized
+            // For the elements of an array, there is one set of keys per element, one after the other.
             // NOTE: OPTIONAL - Can be set to NULL if the entire list is intended to be serialized.
             // WARNING! MUST BE AT LEAST AS LARGE AS THE NUMBER OF KEYS IN THE LIST. (p_key_list->size)
+            // WARNING! FOR ARRAY ELEMENTS, (p_key_list->size * num_elements) OF THE ARRAY.
             bool *p_elements_to_serialize;
+
+            // Deserializer generated from a schema (tools/json_codegen.py) for the same keys as `p_key_list`
+            // NOTE: OPTIONAL - Used in place of the key list when set. Can be NULL.
+            jsonObjectDeserializer_t *p_deserializer;
         };
 
         // Array specific data - (E_JSON_ARRAY)
@@ -214,6 +239,9 @@ typedef struct JsonContainer
             // Table to translate string to an enum
             const enumLabel_t *const enum_labels;
 
+            // Optional, `enum_labels` compiled with elIndexInit(). Used instead of the table when set.
+            const enumLabelIndex_t *const enum_index;
+
             // Element Size, in bytes. For most types this is defined by the type,
             // except for enums and strings.
             // For ENUMS: this should be set to the actual size of the enum type.
@@ -225,6 +253,9 @@ typedef struct JsonContainer
 
             // Number of positions in the array
             int num_elements;
+
+            // Number of positions written to on deserialization
+            int num_elements_deserialized;
         };
     };
 } jsonContainer_t;
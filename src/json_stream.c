@@ -0,0 +1,427 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  json_stream.c
+//
+//  JSON Stream Tokenizer
+//
+//  Module description in json_stream.h
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/* ***************************    Includes     **************************** */
+
+// Standard Includes
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Library Includes
+#include "jsmn/jsmn.h"
+
+// Project Includes
+#include "utility.h"
+
+// Module Includes
+#include "json_stream.h"
+
+/* ***************************   Definitions   **************************** */
+
+#define MODULE_NAME_DEBUG       "JSON_Strm"
+
+/* ****************************   Structures   **************************** */
+
+/* ***********************   Function Prototypes   ************************ */
+
+static void jsonStreamInitCommon(jsonStream_t *const p_stream, const char *const array_path_str, void *const p_cbk_ctx);
+static void jsonStreamKeyAppend(jsonStream_t *const p_stream, const char c);
+static bool jsonStreamIsPathKey(const jsonStream_t *const p_stream, const int path_key_idx);
+static bool jsonStreamIsDelimiter(const char c);
+static bool jsonStreamIsWhitespace(const char c);
+static bool jsonStreamElementAppend(jsonStream_t *const p_stream, const char *const p_data, const size_t len);
+static void jsonStreamEmitElement(jsonStream_t *const p_stream, const char *const p_chunk,
+                                  const size_t start_idx, const size_t end_idx);
+static bool jsonStreamTokenizeElement(jsonStream_t *const p_stream, jsmnTokenizationData_t *const p_tok_data);
+
+/* ***********************   File Scope Variables   *********************** */
+
+/* ****************************   BEGIN CODE   **************************** */
+
+/* *************************   Public  Functions   ************************ */
+
+// Sets up a stream
+// array_path_str[in]: Key path of the array who's elements will be emitted, starting at the root object
+// (i.e. "dates.games"). Every key before the last is an array of objects, and the elements of every
+// array on the path are emitted (same as "dates[*].games[*]"). If NULL, the elements of the root array are emitted.
+// p_filter[in]: Optional, can be NULL. Filter used when tokenizing each element. Paths are relative to the element.
+// p_token_arena[in]: Token storage used for each element, kept by the caller so it can be reused across streams
+// p_element_cbk[in]: Called for each completed element
+void jsonStreamInit(jsonStream_t *const p_stream, const char *const array_path_str,
+                    const jsonPathFilter_t *const p_filter, jsonTokenArena_t *const p_token_arena,
+                    jsonStreamElementCbk_t *const p_element_cbk, void *const p_cbk_ctx)
+{
+    assert((p_element_cbk != NULL) && (p_token_arena != NULL));
+    jsonStreamInitCommon(p_stream, array_path_str, p_cbk_ctx);
+    p_stream->p_filter = p_filter;
+    p_stream->p_token_arena = p_token_arena;
+    p_stream->p_element_cbk = p_element_cbk;
+}
+
+// Sets up a stream that only locates the elements of the array, see jsonStreamInit() for array_path_str.
+// p_span_cbk[in]: Called with the offsets of each completed element
+void jsonStreamInitSpans(jsonStream_t *const p_stream, const char *const array_path_str,
+                         jsonStreamSpanCbk_t *const p_span_cbk, void *const p_cbk_ctx)
+{
+    assert(p_span_cbk != NULL);
+    jsonStreamInitCommon(p_stream, array_path_str, p_cbk_ctx);
+    p_stream->p_span_cbk = p_span_cbk;
+}
+
+// Scans the next chunk of JSON data. Chunks can be split anywhere, including in the middle
+// of strings, escape sequences or numbers.
+// Returns false if the data could not be parsed or the callback stopped the stream.
+bool jsonStreamFeed(jsonStream_t *const p_stream, const char *const p_chunk, const size_t chunk_len)
+{
+    // Start of the bytes of the current element in this chunk, that have not been copied off yet
+    size_t capture_start_idx = 0;
+
+    for (size_t idx = 0; (idx < chunk_len) && !p_stream->failed; idx++)
+    {
+        const char c = p_chunk[idx];
+
+        if (p_stream->in_string)
+        {
+            if (p_stream->in_escape)
+            {
+                p_stream->in_escape = false;
+                jsonStreamKeyAppend(p_stream, c);
+            }
+            else if (c == '\\')
+            {
+                p_stream->in_escape = true;
+                jsonStreamKeyAppend(p_stream, c);
+            }
+            else if (c == '"')
+            {
+                p_stream->in_string = false;
+
+                // An element that is just a string is done at its closing quote
+                if (p_stream->in_element && (p_stream->depth == p_stream->array_depth))
+                {
+                    jsonStreamEmitElement(p_stream, p_chunk, capture_start_idx, (idx + 1));
+                }
+            }
+            else
+            {
+                jsonStreamKeyAppend(p_stream, c);
+            }
+        }
+        else
+        {
+            // A primitive ends at the first character that can't be a part of it.
+            // That character is not part of the element, and still needs to be handled below.
+            if (p_stream->in_primitive && jsonStreamIsDelimiter(c))
+            {
+                p_stream->in_primitive = false;
+                jsonStreamEmitElement(p_stream, p_chunk, capture_start_idx, idx);
+            }
+
+            // Look for the start of the next element of the array
+            if (!p_stream->in_element && (p_stream->array_depth > 0) && (p_stream->depth == p_stream->array_depth) &&
+                !jsonStreamIsWhitespace(c) && (c != ',') && (c != ']'))
+            {
+                p_stream->in_element = true;
+                p_stream->in_primitive = ((c != '{') && (c != '[') && (c != '"'));
+                p_stream->element_start = (p_stream->num_bytes_fed + idx);
+                capture_start_idx = idx;
+            }
+
+            switch (c)
+            {
+                case '"':
+                    p_stream->in_string = true;
+                    p_stream->key_pending = false;
+                    p_stream->key_len = 0;
+                    break;
+
+                case '{':
+                    p_stream->depth++;
+                    p_stream->key_pending = false;
+                    break;
+
+                case '[':
+                    p_stream->depth++;
+                    if (!p_stream->in_element && (p_stream->array_depth == 0))
+                    {
+                        if (p_stream->num_path_keys == 0)
+                        {
+                            // Looking for the root array
+                            if (p_stream->depth == 1)
+                            {
+                                p_stream->array_depth = p_stream->depth;
+                            }
+                        }
+                        else if (jsonStreamIsPathKey(p_stream, p_stream->num_path_keys_matched))
+                        {
+                            if ((p_stream->num_path_keys_matched + 1) == p_stream->num_path_keys)
+                            {
+                                // Everything one level down from here are the elements to emit
+                                p_stream->array_depth = p_stream->depth;
+                            }
+                            else
+                            {
+                                // Array of objects on the path, look for the next key in them
+                                p_stream->num_path_keys_matched++;
+                            }
+                        }
+                    }
+                    p_stream->key_pending = false;
+                    break;
+
+                case '}':
+                case ']':
+                    if ((c == ']') && !p_stream->in_element && (p_stream->depth == p_stream->array_depth))
+                    {
+                        // End of the array, start looking for the next one
+                        p_stream->array_depth = 0;
+                    }
+                    else if ((c == ']') && !p_stream->in_element && (p_stream->num_path_keys_matched > 0) &&
+                             (p_stream->depth == (2 * p_stream->num_path_keys_matched)))
+                    {
+                        // End of an array on the path, back to looking for its key
+                        p_stream->num_path_keys_matched--;
+                    }
+
+                    p_stream->depth--;
+                    p_stream->failed = (p_stream->depth < 0);
+
+                    // Element that is an object or array is done when its closing bracket is seen
+                    if (p_stream->in_element && (p_stream->depth == p_stream->array_depth))
+                    {
+                        jsonStreamEmitElement(p_stream, p_chunk, capture_start_idx, (idx + 1));
+                    }
+                    break;
+
+                case ':':
+                    // The last string was a key
+                    p_stream->key_pending = true;
+                    break;
+
+                case ',':
+                    p_stream->key_pending = false;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+
+    // Whatever there is of the element in progress gets carried over to the next chunk
+    // When only locating elements, the offset of its start is all that is needed
+    if (p_stream->in_element && !p_stream->failed && (p_stream->p_span_cbk == NULL))
+    {
+        p_stream->failed = !jsonStreamElementAppend(p_stream, (p_chunk + capture_start_idx),
+                                                    (chunk_len - capture_start_idx));
+    }
+    p_stream->num_bytes_fed += chunk_len;
+
+    return !p_stream->failed;
+}
+
+// Checks that the stream ended at the end of a complete document
+bool jsonStreamFinish(const jsonStream_t *const p_stream)
+{
+    return (!p_stream->failed && (p_stream->depth == 0) && !p_stream->in_string && !p_stream->in_element);
+}
+
+// Frees the memory held by the stream
+void jsonStreamDestroy(jsonStream_t *const p_stream)
+{
+    free(p_stream->p_element_buff);
+    memset(p_stream, 0, sizeof(jsonStream_t));
+}
+
+/* *************************   Private Functions   ************************ */
+
+// Clears the stream and splits the key path of the array to emit into its keys
+static void jsonStreamInitCommon(jsonStream_t *const p_stream, const char *const array_path_str, void *const p_cbk_ctx)
+{
+    memset(p_stream, 0, sizeof(jsonStream_t));
+
+    if (array_path_str != NULL)
+    {
+        assert((*array_path_str != '\0') && (*array_path_str != '.'));
+        const char *p_key_start = array_path_str;
+        bool at_end = false;
+        while (!at_end)
+        {
+            const char *p_key_end = strchr(p_key_start, '.');
+            at_end = (p_key_end == NULL);
+            if (at_end)
+            {
+                p_key_end = (p_key_start + strlen(p_key_start));
+            }
+
+            // Keys must fit in the buffers, otherwise they could never be matched
+            const int key_len = (int)(p_key_end - p_key_start);
+            assert((p_stream->num_path_keys < JSON_STREAM_MAX_PATH_KEYS) &&
+                   (key_len > 0) && (key_len < JSON_STREAM_MAX_KEY_LEN));
+            memcpy(p_stream->path_keys[p_stream->num_path_keys], p_key_start, key_len);
+            p_stream->path_key_lens[p_stream->num_path_keys] = key_len;
+            p_stream->num_path_keys++;
+
+            p_key_start = (p_key_end + 1);
+        }
+    }
+
+    p_stream->p_cbk_ctx = p_cbk_ctx;
+}
+
+// Keeps track of the last string seen outside of an element, so the key of an array can be checked
+static void jsonStreamKeyAppend(jsonStream_t *const p_stream, const char c)
+{
+    if (!p_stream->in_element)
+    {
+        if (p_stream->key_len < JSON_STREAM_MAX_KEY_LEN)
+        {
+            p_stream->key[p_stream->key_len] = c;
+        }
+
+        // Length keeps counting past the end of the buffer, so a long key can't match a shorter one
+        if (p_stream->key_len <= JSON_STREAM_MAX_KEY_LEN)
+        {
+            p_stream->key_len++;
+        }
+    }
+}
+
+// Determines if the array that just started is the one at the key of the path. The array of the first key is
+// in the root object (depth 2 once opened), and each one after that is in an object element of the previous one.
+static bool jsonStreamIsPathKey(const jsonStream_t *const p_stream, const int path_key_idx)
+{
+    return p_stream->key_pending &&
+           (p_stream->depth == (2 * (path_key_idx + 1))) &&
+           (p_stream->key_len == p_stream->path_key_lens[path_key_idx]) &&
+           (memcmp(p_stream->key, p_stream->path_keys[path_key_idx], p_stream->path_key_lens[path_key_idx]) == 0);
+}
+
+// Characters that end a primitive
+static bool jsonStreamIsDelimiter(const char c)
+{
+    return (jsonStreamIsWhitespace(c) || (c == ',') || (c == ']') || (c == '}') || (c == ':'));
+}
+
+static bool jsonStreamIsWhitespace(const char c)
+{
+    return ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'));
+}
+
+// Copies bytes of the current element into the element buffer, growing it if needed
+static bool jsonStreamElementAppend(jsonStream_t *const p_stream, const char *const p_data, const size_t len)
+{
+    bool success = true;
+    if ((p_stream->element_len + len) > p_stream->element_buff_size)
+    {
+        size_t new_size = MAX(p_stream->element_buff_size, JSON_STREAM_DEFAULT_ELEMENT_SIZE);
+        while (new_size < (p_stream->element_len + len))
+        {
+            new_size *= 2;
+        }
+
+        char *p_new_buff = realloc(p_stream->p_element_buff, new_size);
+        if (p_new_buff != NULL)
+        {
+            p_stream->p_element_buff = p_new_buff;
+            p_stream->element_buff_size = new_size;
+        }
+        else
+        {
+            JSON_DEBUG_MSG("Unable to grow element buffer to %d bytes\n", (int)new_size);
+            success = false;
+        }
+    }
+
+    if (success)
+    {
+        memcpy((p_stream->p_element_buff + p_stream->element_len), p_data, len);
+        p_stream->element_len += len;
+    }
+
+    return success;
+}
+
+// Finishes off the current element (the last of its bytes are in the chunk between the indices),
+// tokenizes it and hands it to the callback. The element buffer is then free to be reused.
+static void jsonStreamEmitElement(jsonStream_t *const p_stream, const char *const p_chunk,
+                                  const size_t start_idx, const size_t end_idx)
+{
+    bool success = true;
+    p_stream->in_element = false;
+
+    if (p_stream->p_span_cbk != NULL)
+    {
+        // Only locating the elements, report where it is
+        p_stream->num_elements++;
+        success = p_stream->p_span_cbk(p_stream->p_cbk_ctx, p_stream->element_start,
+                                       (p_stream->num_bytes_fed + end_idx - p_stream->element_start));
+    }
+    else
+    {
+        success = jsonStreamElementAppend(p_stream, (p_chunk + start_idx), (end_idx - start_idx));
+
+        jsmnTokenizationData_t tok_data;
+        if (success)
+        {
+            success = jsonStreamTokenizeElement(p_stream, &tok_data);
+        }
+
+        if (success)
+        {
+            p_stream->num_elements++;
+            success = p_stream->p_element_cbk(p_stream->p_cbk_ctx, p_stream->p_element_buff,
+                                              (int)p_stream->element_len, &tok_data);
+        }
+
+        // Consumed, release the bytes
+        p_stream->element_len = 0;
+    }
+
+    p_stream->failed = !success;
+}
+
+// Tokenizes the element buffer into the token arena
+static bool jsonStreamTokenizeElement(jsonStream_t *const p_stream, jsmnTokenizationData_t *const p_tok_data)
+{
+    bool success = jsonTokenArenaTokenize(p_stream->p_token_arena, p_stream->p_element_buff, p_stream->element_len,
+                                          p_stream->p_filter, p_tok_data);
+    if (!success)
+    {
+        JSON_DEBUG_MSG("Element %d could not be tokenized\n", p_stream->num_elements);
+    }
+
+    return success;
+}
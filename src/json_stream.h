@@ -0,0 +1,126 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  json_stream.h
+//
+//  JSON Stream Tokenizer
+//
+//  Tokenizes JSON data that arrives in chunks (i.e. straight off of the network)
+//  without ever holding the whole document. The elements of a named array are
+//  captured as they complete, tokenized on their own, and handed to a callback.
+//  Once the callback returns, the element's bytes and tokens are reused, so memory
+//  is bounded by the largest single element rather than the document size.
+//
+//  A stream can also be set up to only locate the elements. The offsets of each element
+//  are then reported instead, and nothing is copied or tokenized (i.e. to split up a document
+//  that is already in memory so its elements can be tokenized in parallel).
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+/* ***************************    Includes     **************************** */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "json_deserialization.h"
+
+/* ***************************   Definitions   **************************** */
+
+// Longest key string that can be matched against a key of the array path. Longer keys never match.
+#define JSON_STREAM_MAX_KEY_LEN             64
+
+// Most keys in the path of the array to emit
+#define JSON_STREAM_MAX_PATH_KEYS           4
+
+// Initial size of the buffer that holds the element being captured, grows as needed
+#define JSON_STREAM_DEFAULT_ELEMENT_SIZE    4096
+
+// Called for every completed element of the array.
+// p_element[in]: The raw bytes of the element. Only valid for the duration of the call.
+// p_tok_data[in]: Tokens of the element, with the element itself as the root (token 0).
+// Return false to stop the stream.
+typedef bool (jsonStreamElementCbk_t)(void *p_ctx, const char *const p_element, const int element_len,
+                                      const jsmnTokenizationData_t *const p_tok_data);
+
+// Called for every completed element of the array when only locating elements.
+// element_start[in]: Offset of the first byte of the element, counted from the first byte fed to the stream.
+// Return false to stop the stream.
+typedef bool (jsonStreamSpanCbk_t)(void *p_ctx, const size_t element_start, const size_t element_len);
+
+/* ****************************   Structures   **************************** */
+
+// State of a stream. All of the members are private to the module, use the functions below.
+typedef struct
+{
+    // Configuration
+    char path_keys[JSON_STREAM_MAX_PATH_KEYS][JSON_STREAM_MAX_KEY_LEN];
+    int path_key_lens[JSON_STREAM_MAX_PATH_KEYS];
+    int num_path_keys; // 0 if the elements of the root array are to be emitted
+    const jsonPathFilter_t *p_filter;
+    jsonStreamElementCbk_t *p_element_cbk;
+    jsonStreamSpanCbk_t *p_span_cbk; // Only one of the two callbacks is set
+    void *p_cbk_ctx;
+
+    // Scanner state, carried from one chunk to the next
+    int depth;          // Nesting depth of objects and arrays
+    int array_depth;    // Depth of the contents of the array being emitted, 0 when not in one
+    int num_path_keys_matched; // Arrays on the path that are currently open, not counting the emitted one
+    bool in_string;
+    bool in_escape;
+    bool in_primitive;
+    bool in_element;    // Bytes are being captured into the element buffer
+    bool key_pending;   // A key and ':' were just seen, waiting on the value
+    char key[JSON_STREAM_MAX_KEY_LEN]; // Last string seen outside of an element
+    int key_len;        // Length of the string in `key`, > JSON_STREAM_MAX_KEY_LEN if it did not fit
+    bool failed;
+
+    // The element currently being captured. This is the only input kept between chunks.
+    char *p_element_buff;
+    size_t element_buff_size;
+    size_t element_len;
+    size_t element_start;   // Offset of the element being captured
+    size_t num_bytes_fed;   // Offset of the start of the current chunk
+
+    // Token storage, reused for every element. Owned by the caller.
+    jsonTokenArena_t *p_token_arena;
+
+    // Number of elements handed to the callback
+    int num_elements;
+} jsonStream_t;
+
+/* ***********************   Function Prototypes   ************************ */
+
+void jsonStreamInit(jsonStream_t *const p_stream, const char *const array_path_str,
+                    const jsonPathFilter_t *const p_filter, jsonTokenArena_t *const p_token_arena,
+                    jsonStreamElementCbk_t *const p_element_cbk, void *const p_cbk_ctx);
+void jsonStreamInitSpans(jsonStream_t *const p_stream, const char *const array_path_str,
+                         jsonStreamSpanCbk_t *const p_span_cbk, void *const p_cbk_ctx);
+bool jsonStreamFeed(jsonStream_t *const p_stream, const char *const p_chunk, const size_t chunk_len);
+bool jsonStreamFinish(const jsonStream_t *const p_stream);
+void jsonStreamDestroy(jsonStream_t *const p_stream);
+
+#endif /* JSON_STREAM_H */
@@ -0,0 +1,523 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  json_string.c
+//
+//  JSON String Decoding
+//
+//  Module description in json_string.h
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+/* ***************************    Includes     **************************** */
+
+// Standard Includes
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project Includes
+#include "utility.h"
+
+// Module Includes
+#include "json_string.h"
+
+/* ***************************   Definitions   **************************** */
+
+// Vector scan of the strings, when the target has the instructions for it (always the case on x64)
+#if defined(__AVX2__)
+#define JSON_STRING_SCAN_AVX2           (1)
+#define JSON_STRING_SCAN_SSE2           (1)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define JSON_STRING_SCAN_AVX2           (0)
+#define JSON_STRING_SCAN_SSE2           (1)
+#include <emmintrin.h>
+#else
+#define JSON_STRING_SCAN_AVX2           (0)
+#define JSON_STRING_SCAN_SSE2           (0)
+#endif
+
+// Written in place of escape sequences and bytes that are not valid UTF-8. Always shorter than what it replaces,
+// so the decoded string is never longer than the token.
+#define JSON_STRING_REPLACEMENT_CHAR    '?'
+
+// Slot of a token offset in the table of decoded strings. Offsets are spread out by a multiplicative hash.
+#define JSON_STRING_CACHE_SLOT(tok_start, mask)     ((int)(((unsigned int)(tok_start) * 2654435761u) & (unsigned int)(mask)))
+
+/* ***********************   Function Prototypes   ************************ */
+
+static int jsonStringDecodeEscape(const char *const p_str, const int len, int idx, uint32_t *const p_code_point);
+static int jsonStringReadHex4(const char *const p_str, const int len, const int idx);
+static int jsonStringUtf8SequenceLen(const uint8_t *const p_str, const int len, const int idx);
+static int jsonStringEncodeUtf8(const uint32_t code_point, char *const p_dest);
+static char *jsonStringCacheAlloc(jsonStringCache_t *const p_cache, const size_t size);
+static bool jsonStringCacheGrow(jsonStringCache_t *const p_cache);
+
+/* ****************************   BEGIN CODE   **************************** */
+
+/* *************************   Public  Functions   ************************ */
+
+// Checks if a string token has escape sequences or non-ASCII characters, i.e. if it can't be used as it is
+bool jsonStringNeedsDecoding(const char *const p_str, const int len)
+{
+    int idx = 0;
+    bool needs_decoding = false;
+
+#if (JSON_STRING_SCAN_AVX2 == 1)
+    const __m256i backslashes_32 = _mm256_set1_epi8('\\');
+    while (!needs_decoding && ((len - idx) >= 32))
+    {
+        // The top bit of non-ASCII bytes is set already, backslashes get theirs from the compare
+        const __m256i block = _mm256_loadu_si256((const __m256i *)&p_str[idx]);
+        needs_decoding = (_mm256_movemask_epi8(_mm256_or_si256(block, _mm256_cmpeq_epi8(block, backslashes_32))) != 0);
+        idx += 32;
+    }
+#endif
+
+#if (JSON_STRING_SCAN_SSE2 == 1)
+    const __m128i backslashes = _mm_set1_epi8('\\');
+    while (!needs_decoding && ((len - idx) >= 16))
+    {
+        const __m128i block = _mm_loadu_si128((const __m128i *)&p_str[idx]);
+        needs_decoding = (_mm_movemask_epi8(_mm_or_si128(block, _mm_cmpeq_epi8(block, backslashes))) != 0);
+        idx += 16;
+    }
+#endif
+
+    for (; !needs_decoding && (idx < len); idx++)
+    {
+        needs_decoding = ((p_str[idx] == '\\') || (((uint8_t)p_str[idx]) >= 0x80));
+    }
+
+    return needs_decoding;
+}
+
+// Decodes the escape sequences of a string token into UTF-8, and replaces the bytes that are not valid UTF-8.
+// Escapes that are not valid (or \u0000, which can't be part of a C string) are replaced as well.
+// The destination is always NULL terminated. If it is too small, the string is cut before the character that
+// does not fit. The decoded string is never longer than the token.
+// Returns the length of the decoded string, not counting the NULL byte.
+int jsonStringDecode(const char *const p_str, const int len, char *const p_dest, const int dest_size)
+{
+    assert(dest_size > 0);
+
+    int idx = 0;
+    int dest_len = 0;
+    bool fits = true;
+    while (fits && (idx < len))
+    {
+        char encoded[4];
+        int encoded_len;
+
+        if (p_str[idx] == '\\')
+        {
+            uint32_t code_point;
+            idx = jsonStringDecodeEscape(p_str, len, idx, &code_point);
+            encoded_len = jsonStringEncodeUtf8(code_point, encoded);
+        }
+        else
+        {
+            // Valid UTF-8 sequences are copied as they are
+            encoded_len = jsonStringUtf8SequenceLen((const uint8_t *)p_str, len, idx);
+            if (encoded_len > 0)
+            {
+                memcpy(encoded, &p_str[idx], encoded_len);
+                idx += encoded_len;
+            }
+            else
+            {
+                encoded[0] = JSON_STRING_REPLACEMENT_CHAR;
+                encoded_len = 1;
+                idx++;
+            }
+        }
+
+        fits = ((dest_len + encoded_len) < dest_size);
+        if (fits)
+        {
+            memcpy(&p_dest[dest_len], encoded, encoded_len);
+            dest_len += encoded_len;
+        }
+    }
+
+    p_dest[dest_len] = '\0';
+    return dest_len;
+}
+
+// Copies a string token into a buffer, decoding it if needed. Plain strings are copied as they are.
+// See jsonStringDecode() for how the destination is filled in.
+// Returns the length of the copied string, not counting the NULL byte.
+int jsonStringCopy(const char *const p_str, const int len, char *const p_dest, const int dest_size)
+{
+    assert(dest_size > 0);
+
+    int dest_len;
+    if (jsonStringNeedsDecoding(p_str, len))
+    {
+        dest_len = jsonStringDecode(p_str, len, p_dest, dest_size);
+    }
+    else
+    {
+        dest_len = min(len, (dest_size - 1));
+        memcpy(p_dest, p_str, dest_len);
+        p_dest[dest_len] = '\0';
+    }
+
+    return dest_len;
+}
+
+// Sets up an empty cache, nothing is allocated until a string is decoded
+void jsonStringCacheInit(jsonStringCache_t *const p_cache)
+{
+    memset(p_cache, 0, sizeof(jsonStringCache_t));
+}
+
+// Forgets the strings decoded so far (i.e. before another JSON document is deserialized). The memory is kept
+// for the next strings. Strings that were handed out are no longer valid.
+void jsonStringCacheReset(jsonStringCache_t *const p_cache)
+{
+    for (jsonStringBlock_t *p_block = p_cache->p_blocks; p_block != NULL; p_block = p_block->p_next)
+    {
+        p_block->used = 0;
+    }
+
+    for (int idx = 0; idx < p_cache->capacity; idx++)
+    {
+        p_cache->p_entries[idx].tok_start = -1;
+    }
+    p_cache->num_entries = 0;
+}
+
+// Frees the memory held by the cache. The stats are kept.
+void jsonStringCacheDestroy(jsonStringCache_t *const p_cache)
+{
+    jsonStringBlock_t *p_block = p_cache->p_blocks;
+    while (p_block != NULL)
+    {
+        jsonStringBlock_t *p_next_block = p_block->p_next;
+        free(p_block);
+        p_block = p_next_block;
+    }
+
+    free(p_cache->p_entries);
+    p_cache->p_blocks = NULL;
+    p_cache->p_entries = NULL;
+    p_cache->capacity = 0;
+    p_cache->num_entries = 0;
+}
+
+// Gets the text of a string token. Plain strings point into the JSON data, the others are decoded into the
+// cache the first time they are asked for. The cache must only ever be used with one JSON document at a time.
+// p_cache[in]: Can be NULL, the raw token is then returned
+jsonStr_t jsonStringCacheGet(jsonStringCache_t *const p_cache, const char *const p_json_buff,
+                             const jsmntok_t *const p_tok)
+{
+    jsonStr_t str = {.str = &p_json_buff[p_tok->start], .len = (p_tok->end - p_tok->start)};
+
+    if ((p_cache != NULL) && jsonStringNeedsDecoding(str.str, str.len))
+    {
+        // Keep the table at most half full
+        bool has_room = ((p_cache->num_entries * 2) < p_cache->capacity) || jsonStringCacheGrow(p_cache);
+
+        int entry_idx = -1;
+        bool found = false;
+        if (has_room)
+        {
+            const int mask = (p_cache->capacity - 1);
+            entry_idx = JSON_STRING_CACHE_SLOT(p_tok->start, mask);
+            while (!found && (p_cache->p_entries[entry_idx].tok_start != -1))
+            {
+                found = (p_cache->p_entries[entry_idx].tok_start == p_tok->start);
+                entry_idx = found ? entry_idx : ((entry_idx + 1) & mask);
+            }
+        }
+
+        if (found)
+        {
+            str = p_cache->p_entries[entry_idx].decoded;
+        }
+        else if (has_room)
+        {
+            char *p_decoded = jsonStringCacheAlloc(p_cache, (size_t)str.len + 1);
+            if (p_decoded != NULL)
+            {
+                str.len = jsonStringDecode(str.str, str.len, p_decoded, (str.len + 1));
+                str.str = p_decoded;
+
+                p_cache->p_entries[entry_idx].tok_start = p_tok->start;
+                p_cache->p_entries[entry_idx].decoded = str;
+                p_cache->num_entries++;
+                p_cache->num_decoded++;
+            }
+        }
+    }
+
+    return str;
+}
+
+/* *************************   Private Functions   ************************ */
+
+// Decodes the escape sequence at idx. A surrogate pair written as two \u escapes is decoded as one character.
+// Returns the index following the escape sequence.
+static int jsonStringDecodeEscape(const char *const p_str, const int len, int idx, uint32_t *const p_code_point)
+{
+    const char escaped = ((idx + 1) < len) ? p_str[idx + 1] : '\0';
+    idx += 2;
+
+    switch (escaped)
+    {
+        case '"':
+        case '\\':
+        case '/':
+            *p_code_point = (uint32_t)escaped;
+            break;
+
+        case 'b':
+            *p_code_point = '\b';
+            break;
+
+        case 'f':
+            *p_code_point = '\f';
+            break;
+
+        case 'n':
+            *p_code_point = '\n';
+            break;
+
+        case 'r':
+            *p_code_point = '\r';
+            break;
+
+        case 't':
+            *p_code_point = '\t';
+            break;
+
+        case 'u':
+        {
+            const int first = jsonStringReadHex4(p_str, len, idx);
+            const int second = (((idx + 10) <= len) && (p_str[idx + 4] == '\\') && (p_str[idx + 5] == 'u')) ?
+                               jsonStringReadHex4(p_str, len, (idx + 6)) : -1;
+
+            if ((first >= 0xD800) && (first <= 0xDBFF) && (second >= 0xDC00) && (second <= 0xDFFF))
+            {
+                *p_code_point = (0x10000 + (((uint32_t)first - 0xD800) << 10) + ((uint32_t)second - 0xDC00));
+                idx += 10;
+            }
+            else if ((first > 0) && ((first < 0xD800) || (first > 0xDFFF)))
+            {
+                *p_code_point = (uint32_t)first;
+                idx += 4;
+            }
+            else
+            {
+                // Not hex, \u0000, or half of a surrogate pair
+                *p_code_point = JSON_STRING_REPLACEMENT_CHAR;
+                idx += ((first >= 0) ? 4 : 0);
+            }
+            break;
+        }
+
+        default:
+            *p_code_point = JSON_STRING_REPLACEMENT_CHAR;
+            break;
+    }
+
+    return min(idx, len);
+}
+
+// Reads the 4 hex digits of a \u escape. Returns -1 if they are not all there.
+static int jsonStringReadHex4(const char *const p_str, const int len, const int idx)
+{
+    int value = ((idx + 4) <= len) ? 0 : -1;
+    for (int digit_idx = idx; (value >= 0) && (digit_idx < (idx + 4)); digit_idx++)
+    {
+        const char c = p_str[digit_idx];
+        if ((c >= '0') && (c <= '9'))
+        {
+            value = (value << 4) | (c - '0');
+        }
+        else if ((c >= 'a') && (c <= 'f'))
+        {
+            value = (value << 4) | (c - 'a' + 10);
+        }
+        else if ((c >= 'A') && (c <= 'F'))
+        {
+            value = (value << 4) | (c - 'A' + 10);
+        }
+        else
+        {
+            value = -1;
+        }
+    }
+
+    return value;
+}
+
+// Gets the length of the UTF-8 sequence at idx, 0 if it is not valid (overlong, surrogate, past U+10FFFF or cut short)
+static int jsonStringUtf8SequenceLen(const uint8_t *const p_str, const int len, const int idx)
+{
+    const uint8_t lead = p_str[idx];
+
+    // Range of the first continuation byte depends on the lead byte, the other ones are always 0x80-0xBF
+    int seq_len = 0;
+    uint8_t second_min = 0x80;
+    uint8_t second_max = 0xBF;
+    if (lead < 0x80)
+    {
+        seq_len = 1;
+    }
+    else if ((lead >= 0xC2) && (lead <= 0xDF))
+    {
+        seq_len = 2;
+    }
+    else if ((lead >= 0xE0) && (lead <= 0xEF))
+    {
+        seq_len = 3;
+        second_min = (lead == 0xE0) ? 0xA0 : 0x80;
+        second_max = (lead == 0xED) ? 0x9F : 0xBF;
+    }
+    else if ((lead >= 0xF0) && (lead <= 0xF4))
+    {
+        seq_len = 4;
+        second_min = (lead == 0xF0) ? 0x90 : 0x80;
+        second_max = (lead == 0xF4) ? 0x8F : 0xBF;
+    }
+
+    bool valid = ((seq_len > 0) && ((idx + seq_len) <= len));
+    for (int byte_idx = 1; valid && (byte_idx < seq_len); byte_idx++)
+    {
+        const uint8_t byte = p_str[idx + byte_idx];
+        valid = (byte_idx == 1) ? ((byte >= second_min) && (byte <= second_max)) : ((byte >= 0x80) && (byte <= 0xBF));
+    }
+
+    return (valid ? seq_len : 0);
+}
+
+// Writes a code point as UTF-8. Returns the number of bytes written.
+static int jsonStringEncodeUtf8(const uint32_t code_point, char *const p_dest)
+{
+    int encoded_len;
+    if (code_point < 0x80)
+    {
+        p_dest[0] = (char)code_point;
+        encoded_len = 1;
+    }
+    else if (code_point < 0x800)
+    {
+        p_dest[0] = (char)(0xC0 | (code_point >> 6));
+        p_dest[1] = (char)(0x80 | (code_point & 0x3F));
+        encoded_len = 2;
+    }
+    else if (code_point < 0x10000)
+    {
+        p_dest[0] = (char)(0xE0 | (code_point >> 12));
+        p_dest[1] = (char)(0x80 | ((code_point >> 6) & 0x3F));
+        p_dest[2] = (char)(0x80 | (code_point & 0x3F));
+        encoded_len = 3;
+    }
+    else
+    {
+        p_dest[0] = (char)(0xF0 | (code_point >> 18));
+        p_dest[1] = (char)(0x80 | ((code_point >> 12) & 0x3F));
+        p_dest[2] = (char)(0x80 | ((code_point >> 6) & 0x3F));
+        p_dest[3] = (char)(0x80 | (code_point & 0x3F));
+        encoded_len = 4;
+    }
+
+    return encoded_len;
+}
+
+// Gets space for a decoded string out of the blocks, adding a block if none of them has enough room left
+static char *jsonStringCacheAlloc(jsonStringCache_t *const p_cache, const size_t size)
+{
+    jsonStringBlock_t *p_block = p_cache->p_blocks;
+    while ((p_block != NULL) && ((p_block->size - p_block->used) < size))
+    {
+        p_block = p_block->p_next;
+    }
+
+    if (p_block == NULL)
+    {
+        const size_t block_size = MAX(size, JSON_STRING_CACHE_BLOCK_SIZE);
+        p_block = malloc(sizeof(jsonStringBlock_t) + block_size);
+        if (p_block != NULL)
+        {
+            p_block->size = block_size;
+            p_block->used = 0;
+            p_block->p_next = p_cache->p_blocks;
+            p_cache->p_blocks = p_block;
+        }
+    }
+
+    char *p_space = NULL;
+    if (p_block != NULL)
+    {
+        // String storage follows the block header
+        p_space = ((char *)(p_block + 1) + p_block->used);
+        p_block->used += size;
+    }
+
+    return p_space;
+}
+
+// Doubles the size of the table of decoded strings
+static bool jsonStringCacheGrow(jsonStringCache_t *const p_cache)
+{
+    const int new_capacity = (p_cache->capacity > 0) ? (p_cache->capacity * 2) : JSON_STRING_CACHE_DEFAULT_ENTRIES;
+    jsonStringCacheEntry_t *p_new_entries = malloc(new_capacity * sizeof(jsonStringCacheEntry_t));
+
+    if (p_new_entries != NULL)
+    {
+        for (int idx = 0; idx < new_capacity; idx++)
+        {
+            p_new_entries[idx].tok_start = -1;
+        }
+
+        // Put the strings decoded so far back in, at their place in the larger table
+        const int mask = (new_capacity - 1);
+        for (int idx = 0; idx < p_cache->capacity; idx++)
+        {
+            const jsonStringCacheEntry_t *const p_entry = &p_cache->p_entries[idx];
+            if (p_entry->tok_start != -1)
+            {
+                int new_idx = JSON_STRING_CACHE_SLOT(p_entry->tok_start, mask);
+                while (p_new_entries[new_idx].tok_start != -1)
+                {
+                    new_idx = ((new_idx + 1) & mask);
+                }
+                p_new_entries[new_idx] = *p_entry;
+            }
+        }
+
+        free(p_cache->p_entries);
+        p_cache->p_entries = p_new_entries;
+        p_cache->capacity = new_capacity;
+    }
+
+    return (p_new_entries != NULL);
+}
@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  json_string.h
+//
+//  JSON String Decoding
+//
+//  Turns the raw bytes of JSON string tokens into text: escape sequences (i.e. \" or \u00e9) are
+//  decoded into UTF-8, and the UTF-8 is validated. Most strings have neither escapes nor non-ASCII
+//  characters, so strings are first scanned 16 (SSE2) or 32 (AVX2) bytes at a time, and strings that
+//  turn out to be plain ASCII are used as they are. Only the others go through the decoder.
+//
+//  Decoded strings are kept in a cache, so jsonStr_t values can point to the decoded text instead
+//  of into the JSON data. Each token arena has its own cache, emptied when the arena is reused.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef JSON_STRING_H
+#define JSON_STRING_H
+
+/* ***************************    Includes     **************************** */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "json_serialize_deserialize_types.h"
+
+/* ***************************   Definitions   **************************** */
+
+// Size of the blocks decoded strings are stored in. Longer strings get a block of their own.
+#define JSON_STRING_CACHE_BLOCK_SIZE        4096
+
+// Number of strings the cache can hold before its table is grown
+#define JSON_STRING_CACHE_DEFAULT_ENTRIES   64
+
+/* ****************************   Structures   **************************** */
+
+// Storage for decoded strings. Strings are never moved once decoded.
+typedef struct JsonStringBlock
+{
+    struct JsonStringBlock *p_next;
+    size_t size;    // Bytes of string storage, which follows the block header
+    size_t used;
+} jsonStringBlock_t;
+
+// A decoded string, found by the offset of its token in the JSON data
+typedef struct
+{
+    int tok_start; // -1 for unused entries
+    jsonStr_t decoded;
+} jsonStringCacheEntry_t;
+
+// Strings decoded out of one JSON document. All of the members are private to the module.
+typedef struct JsonStringCache
+{
+    jsonStringBlock_t *p_blocks;
+    jsonStringCacheEntry_t *p_entries;  // Open addressing, `capacity` is a power of 2
+    int capacity;
+    int num_entries;
+
+    // Stats
+    int num_decoded;    // Strings decoded since the cache was initialized
+} jsonStringCache_t;
+
+/* ***********************   Function Prototypes   ************************ */
+
+bool jsonStringNeedsDecoding(const char *const p_str, const int len);
+int jsonStringDecode(const char *const p_str, const int len, char *const p_dest, const int dest_size);
+int jsonStringCopy(const char *const p_str, const int len, char *const p_dest, const int dest_size);
+
+void jsonStringCacheInit(jsonStringCache_t *const p_cache);
+void jsonStringCacheReset(jsonStringCache_t *const p_cache);
+void jsonStringCacheDestroy(jsonStringCache_t *const p_cache);
+jsonStr_t jsonStringCacheGet(jsonStringCache_t *const p_cache, const char *const p_json_buff,
+                             const jsmntok_t *const p_tok);
+
+#endif /* JSON_STRING_H */
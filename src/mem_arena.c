@@ -0,0 +1,179 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  mem_arena.c
+//
+//  Memory Arena
+//
+//  Module description in mem_arena.h
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/* ***************************    Includes     **************************** */
+
+// Standard Includes
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+// Project Includes
+#include "utility.h"
+
+// Module Includes
+#include "mem_arena.h"
+
+/* ***************************   Definitions   **************************** */
+
+// Rounds a size up to the alignment of the allocations
+#define MEM_ARENA_ALIGN(size)   (((size) + (MEM_ARENA_ALIGNMENT - 1)) & ~((size_t)MEM_ARENA_ALIGNMENT - 1))
+
+// Storage of a block starts after its header, which is padded out to the alignment
+#define MEM_ARENA_BLOCK_DATA(p_block)   ((char *)(p_block) + MEM_ARENA_ALIGN(sizeof(memArenaBlock_t)))
+
+/* ***********************   Function Prototypes   ************************ */
+
+static memArenaBlock_t *memArenaAddBlock(memArena_t *const p_arena, const size_t min_size);
+
+/* ****************************   BEGIN CODE   **************************** */
+
+/* *************************   Public  Functions   ************************ */
+
+// Sets up an empty arena, nothing is allocated until the first allocation.
+// `first_block_size` can be 0 for the default, or the expected total size so everything fits in one block.
+void memArenaInit(memArena_t *const p_arena, const size_t first_block_size)
+{
+    p_arena->p_blocks = NULL;
+    p_arena->next_block_size = (first_block_size > 0) ? MEM_ARENA_ALIGN(first_block_size) : MEM_ARENA_DEFAULT_BLOCK_SIZE;
+    p_arena->num_blocks = 0;
+    p_arena->allocated_bytes = 0;
+    p_arena->used_bytes = 0;
+}
+
+// Frees every block of the arena, and everything that was allocated out of it
+// NOTE: The arena struct itself may be in one of the blocks, so it is not touched once the blocks are freed
+void memArenaDestroy(memArena_t *const p_arena)
+{
+    memArenaBlock_t *p_block = p_arena->p_blocks;
+    while (p_block != NULL)
+    {
+        memArenaBlock_t *p_next_block = p_block->p_next;
+        free(p_block);
+        p_block = p_next_block;
+    }
+}
+
+// Gets `size` bytes out of the arena, aligned to MEM_ARENA_ALIGNMENT. Returns NULL if a block could not be added.
+void *memArenaAlloc(memArena_t *const p_arena, const size_t size)
+{
+    const size_t aligned_size = MEM_ARENA_ALIGN(MAX(size, 1));
+
+    memArenaBlock_t *p_block = p_arena->p_blocks;
+    if ((p_block == NULL) || ((p_block->size - p_block->used) < aligned_size))
+    {
+        // Whatever is left of the current block is given up on
+        p_block = memArenaAddBlock(p_arena, aligned_size);
+    }
+
+    void *p_space = NULL;
+    if (p_block != NULL)
+    {
+        p_space = (MEM_ARENA_BLOCK_DATA(p_block) + p_block->used);
+        p_block->used += aligned_size;
+        p_arena->used_bytes += aligned_size;
+    }
+
+    return p_space;
+}
+
+// Copies `len` characters of a string into the arena, NULL terminated. `p_str` can be NULL when `len` is 0.
+char *memArenaStrDup(memArena_t *const p_arena, const char *const p_str, const int len)
+{
+    char *p_copy = memArenaAlloc(p_arena, (size_t)len + 1);
+    if (p_copy != NULL)
+    {
+        if (len > 0)
+        {
+            memcpy(p_copy, p_str, len);
+        }
+        p_copy[len] = '\0';
+    }
+
+    return p_copy;
+}
+
+// Moves every block of `p_src` into the arena, `p_src` is left empty. Allocations keep coming out of the
+// arena's current block, the blocks taken over are only freed with it.
+void memArenaAppend(memArena_t *const p_arena, memArena_t *const p_src)
+{
+    if (p_src->p_blocks != NULL)
+    {
+        memArenaBlock_t *p_last_block = p_src->p_blocks;
+        while (p_last_block->p_next != NULL)
+        {
+            p_last_block = p_last_block->p_next;
+        }
+
+        if (p_arena->p_blocks != NULL)
+        {
+            // Behind the current block, so it stays first
+            p_last_block->p_next = p_arena->p_blocks->p_next;
+            p_arena->p_blocks->p_next = p_src->p_blocks;
+        }
+        else
+        {
+            p_arena->p_blocks = p_src->p_blocks;
+        }
+
+        p_arena->num_blocks += p_src->num_blocks;
+        p_arena->allocated_bytes += p_src->allocated_bytes;
+        p_arena->used_bytes += p_src->used_bytes;
+    }
+
+    memArenaInit(p_src, p_src->next_block_size);
+}
+
+/* *************************   Private Functions   ************************ */
+
+// Adds a block with room for at least `min_size` bytes in front of the others. The block after it is twice
+// as large, up to MEM_ARENA_MAX_BLOCK_SIZE.
+static memArenaBlock_t *memArenaAddBlock(memArena_t *const p_arena, const size_t min_size)
+{
+    const size_t block_size = MAX(min_size, p_arena->next_block_size);
+    memArenaBlock_t *p_block = malloc(MEM_ARENA_ALIGN(sizeof(memArenaBlock_t)) + block_size);
+    if (p_block != NULL)
+    {
+        p_block->size = block_size;
+        p_block->used = 0;
+        p_block->p_next = p_arena->p_blocks;
+        p_arena->p_blocks = p_block;
+
+        p_arena->next_block_size = MAX(p_arena->next_block_size, min((p_arena->next_block_size * 2), MEM_ARENA_MAX_BLOCK_SIZE));
+        p_arena->num_blocks++;
+        p_arena->allocated_bytes += block_size;
+    }
+
+    return p_block;
+}
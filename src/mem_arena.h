@@ -0,0 +1,83 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  mem_arena.h
+//
+//  Memory Arena
+//
+//  Bump allocator for data that is built up piece by piece and then all freed at once (i.e. a list
+//  of games). Allocations are carved out of large blocks, one after the other, and are never freed
+//  on their own: destroying the arena frees every block. Block sizes double as the arena grows, so
+//  a whole dataset ends up in a handful of blocks.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef MEM_ARENA_H
+#define MEM_ARENA_H
+
+/* ***************************    Includes     **************************** */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ***************************   Definitions   **************************** */
+
+// Size of the first block when none is given, and the size blocks stop doubling at.
+// Allocations larger than the next block size get a block of their own.
+#define MEM_ARENA_DEFAULT_BLOCK_SIZE    (16 * 1024)
+#define MEM_ARENA_MAX_BLOCK_SIZE        (1024 * 1024)
+
+// Every allocation is aligned to this, enough for any of the types stored in arenas
+#define MEM_ARENA_ALIGNMENT             16
+
+/* ****************************   Structures   **************************** */
+
+typedef struct MemArenaBlock
+{
+    struct MemArenaBlock *p_next;
+    size_t size;    // Bytes of storage, which follows the block header
+    size_t used;
+} memArenaBlock_t;
+
+// All of the members are private to the module, except for the stats
+typedef struct
+{
+    memArenaBlock_t *p_blocks;  // Newest first, allocations come out of the first block
+    size_t next_block_size;
+
+    // Stats
+    int num_blocks;
+    size_t allocated_bytes;     // Sum of the block sizes
+    size_t used_bytes;          // Bytes handed out, including the alignment padding
+} memArena_t;
+
+/* ***********************   Function Prototypes   ************************ */
+
+void memArenaInit(memArena_t *const p_arena, const size_t first_block_size);
+void memArenaDestroy(memArena_t *const p_arena);
+void *memArenaAlloc(memArena_t *const p_arena, const size_t size);
+char *memArenaStrDup(memArena_t *const p_arena, const char *const p_str, const int len);
+void memArenaAppend(memArena_t *const p_arena, memArena_t *const p_src);
+
+#endif /* MEM_ARENA_H */
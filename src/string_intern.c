@@ -0,0 +1,196 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  string_intern.c
+//
+//  String Interning
+//
+//  Module description in string_intern.h
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+/* ***************************    Includes     **************************** */
+
+// Std Includes
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Lib Includes
+#include <SDL.h>
+#include "jsmn/jsmn.h"
+
+// Module Includes
+#include "string_intern.h"
+
+/* ***************************   Definitions   **************************** */
+
+#define STRING_INTERN_SLOT(hash, mask)  ((int)((hash) & (unsigned int)(mask)))
+
+/* ***********************   Function Prototypes   ************************ */
+
+static int stringInternFind(const stringInternTable_t *const p_table, const char *const p_str, const int len,
+                            const unsigned int hash, int *const p_slot_idx);
+static bool stringInternGrow(stringInternTable_t *const p_table);
+
+/* ****************************   BEGIN CODE   **************************** */
+
+/* *************************   Public  Functions   ************************ */
+
+// Sets up an empty table, nothing is allocated until the first string is added
+void stringInternInit(stringInternTable_t *const p_table)
+{
+    memset(p_table, 0, sizeof(stringInternTable_t));
+    memArenaInit(&p_table->strings, STRING_INTERN_BLOCK_SIZE);
+}
+
+// Frees the table and every string in it. The stats are kept.
+void stringInternDestroy(stringInternTable_t *const p_table)
+{
+    memArenaDestroy(&p_table->strings);
+    memArenaInit(&p_table->strings, STRING_INTERN_BLOCK_SIZE);
+
+    free(p_table->p_entries);
+    free(p_table->p_slots);
+    p_table->p_entries = NULL;
+    p_table->p_slots = NULL;
+    p_table->capacity = 0;
+    p_table->num_entries = 0;
+}
+
+// Gets the id of the `len` characters at `p_str`, adding a copy of them to the table the first time they are seen.
+// The copy is returned in `pp_interned`, it is valid until the table is destroyed.
+// Returns STRING_INTERN_ID_NONE, and leaves `pp_interned` alone, if the string could not be added.
+int stringInternAdd(stringInternTable_t *const p_table, const char *const p_str, const int len,
+                    const char **const pp_interned)
+{
+    const unsigned int hash = jsmn_hash(p_str, len);
+
+    SDL_AtomicLock(&p_table->lock);
+    p_table->num_lookups++;
+
+    int slot_idx = -1;
+    int id = stringInternFind(p_table, p_str, len, hash, &slot_idx);
+    if ((id == STRING_INTERN_ID_NONE) && (p_table->num_entries < STRING_INTERN_MAX_ENTRIES))
+    {
+        // Keep the table at most half full, its slot moves when it grows
+        if (((p_table->num_entries * 2) >= p_table->capacity) && stringInternGrow(p_table))
+        {
+            stringInternFind(p_table, p_str, len, hash, &slot_idx);
+        }
+
+        char *p_copy = ((p_table->num_entries * 2) < p_table->capacity) ?
+                       memArenaStrDup(&p_table->strings, p_str, len) : NULL;
+        if (p_copy != NULL)
+        {
+            id = p_table->num_entries;
+            p_table->p_entries[id].str = p_copy;
+            p_table->p_entries[id].len = len;
+            p_table->p_entries[id].hash = hash;
+            p_table->p_slots[slot_idx] = id;
+            p_table->num_entries++;
+        }
+    }
+
+    if (id != STRING_INTERN_ID_NONE)
+    {
+        *pp_interned = p_table->p_entries[id].str;
+    }
+    SDL_AtomicUnlock(&p_table->lock);
+
+    return id;
+}
+
+/* *************************   Private Functions   ************************ */
+
+// Looks a string up. Returns its id, or STRING_INTERN_ID_NONE with `p_slot_idx` set to the free slot it would go in
+// (-1 when the table is empty).
+static int stringInternFind(const stringInternTable_t *const p_table, const char *const p_str, const int len,
+                            const unsigned int hash, int *const p_slot_idx)
+{
+    int id = STRING_INTERN_ID_NONE;
+    int slot_idx = -1;
+
+    if (p_table->capacity > 0)
+    {
+        const int mask = (p_table->capacity - 1);
+        slot_idx = STRING_INTERN_SLOT(hash, mask);
+
+        bool found = false;
+        while (!found && (p_table->p_slots[slot_idx] != STRING_INTERN_ID_NONE))
+        {
+            const stringInternEntry_t *const p_entry = &p_table->p_entries[p_table->p_slots[slot_idx]];
+            found = ((p_entry->hash == hash) && (p_entry->len == len) && (memcmp(p_entry->str, p_str, len) == 0));
+            id = found ? p_table->p_slots[slot_idx] : id;
+            slot_idx = found ? slot_idx : ((slot_idx + 1) & mask);
+        }
+    }
+
+    *p_slot_idx = slot_idx;
+    return id;
+}
+
+// Doubles the size of the table
+static bool stringInternGrow(stringInternTable_t *const p_table)
+{
+    const int new_capacity = (p_table->capacity > 0) ? (p_table->capacity * 2) : STRING_INTERN_DEFAULT_ENTRIES;
+    int *p_new_slots = malloc(new_capacity * sizeof(int));
+    stringInternEntry_t *p_new_entries = realloc(p_table->p_entries, (new_capacity / 2) * sizeof(stringInternEntry_t));
+
+    if (p_new_entries != NULL)
+    {
+        p_table->p_entries = p_new_entries;
+    }
+
+    const bool success = ((p_new_slots != NULL) && (p_new_entries != NULL));
+    if (success)
+    {
+        for (int idx = 0; idx < new_capacity; idx++)
+        {
+            p_new_slots[idx] = STRING_INTERN_ID_NONE;
+        }
+
+        // Put the strings added so far back in, at their place in the larger table
+        const int mask = (new_capacity - 1);
+        for (int id = 0; id < p_table->num_entries; id++)
+        {
+            int slot_idx = STRING_INTERN_SLOT(p_table->p_entries[id].hash, mask);
+            while (p_new_slots[slot_idx] != STRING_INTERN_ID_NONE)
+            {
+                slot_idx = ((slot_idx + 1) & mask);
+            }
+            p_new_slots[slot_idx] = id;
+        }
+
+        free(p_table->p_slots);
+        p_table->p_slots = p_new_slots;
+        p_table->capacity = new_capacity;
+    }
+    else
+    {
+        free(p_new_slots);
+    }
+
+    return success;
+}
@@ -0,0 +1,96 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  string_intern.h
+//
+//  String Interning
+//
+//  Keeps a single copy of each distinct string (i.e. team names, game states), so text that is
+//  repeated across thousands of games takes the memory of one. Each distinct string is given an id,
+//  numbered from 0 in the order the strings are first added, which can be used to share anything
+//  built from the string (i.e. a rendered text texture). Strings are never removed, the memory
+//  stays bounded by the number of distinct strings.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef STRING_INTERN_H
+#define STRING_INTERN_H
+
+/* ***************************    Includes     **************************** */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <SDL.h>
+
+#include "mem_arena.h"
+
+/* ***************************   Definitions   **************************** */
+
+// Id of strings that are not in a table
+#define STRING_INTERN_ID_NONE               (-1)
+
+// Number of strings the table can hold before it is grown
+#define STRING_INTERN_DEFAULT_ENTRIES       64
+
+// Most distinct strings a table takes, further strings are turned away so a document full of unique
+// values can't grow the table without bound
+#define STRING_INTERN_MAX_ENTRIES           4096
+
+// Size of the first block of string storage
+#define STRING_INTERN_BLOCK_SIZE            4096
+
+/* ****************************   Structures   **************************** */
+
+// A distinct string, found by its id
+typedef struct
+{
+    const char *str;    // NULL terminated, `len` does not count the NULL byte
+    int len;
+    unsigned int hash;
+} stringInternEntry_t;
+
+// All of the members are private to the module, except for the stats.
+// Strings can be added from several threads at once.
+typedef struct
+{
+    memArena_t strings;
+    stringInternEntry_t *p_entries; // Indexed by id, room for half of `capacity`
+    int *p_slots;                   // Open addressing on the hash, ids or STRING_INTERN_ID_NONE, `capacity` is a power of 2
+    int capacity;
+    SDL_SpinLock lock;
+
+    // Stats
+    int num_entries;
+    int num_lookups;    // Strings added, whether they were in the table already or not
+} stringInternTable_t;
+
+/* ***********************   Function Prototypes   ************************ */
+
+void stringInternInit(stringInternTable_t *const p_table);
+void stringInternDestroy(stringInternTable_t *const p_table);
+int stringInternAdd(stringInternTable_t *const p_table, const char *const p_str, const int len,
+                    const char **const pp_interned);
+
+#endif /* STRING_INTERN_H */
@@ -0,0 +1,204 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  worker_pool.c
+//
+//  Worker Pool
+//
+//  Module description in worker_pool.h
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+
+/* ***************************    Includes     **************************** */
+
+// Standard Includes
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Module Includes
+#include "worker_pool.h"
+
+/* ***********************   Function Prototypes   ************************ */
+
+static int SDLCALL workerPoolThreadMain(void *p_data);
+static void workerPoolRunJobs(workerPool_t *const p_pool, const int worker_idx);
+
+/* ****************************   BEGIN CODE   **************************** */
+
+/* *************************   Public  Functions   ************************ */
+
+// Starts the threads of a pool. num_threads includes the thread that will be posting the jobs, so a pool
+// of 1 starts no threads at all. If threads can't be started, the pool makes do with the ones it has, down
+// to running every job on the posting thread.
+void workerPoolInit(workerPool_t *const p_pool, const int num_threads)
+{
+    assert((num_threads > 0) && (num_threads <= WORKER_POOL_MAX_THREADS));
+    memset(p_pool, 0, sizeof(workerPool_t));
+
+    p_pool->num_threads = 1;
+    p_pool->threads[0].p_pool = p_pool;
+
+    if (num_threads > 1)
+    {
+        p_pool->p_lock = SDL_CreateMutex();
+        p_pool->p_jobs_posted = SDL_CreateCond();
+        p_pool->p_batch_done = SDL_CreateCond();
+    }
+
+    if ((p_pool->p_lock != NULL) && (p_pool->p_jobs_posted != NULL) && (p_pool->p_batch_done != NULL))
+    {
+        bool thread_started = true;
+        for (int idx = 1; (idx < num_threads) && thread_started; idx++)
+        {
+            workerPoolThread_t *const p_thread = &p_pool->threads[idx];
+            p_thread->p_pool = p_pool;
+            p_thread->worker_idx = idx;
+            p_thread->p_thread = SDL_CreateThread(workerPoolThreadMain, "WorkerPool", p_thread);
+
+            thread_started = (p_thread->p_thread != NULL);
+            p_pool->num_threads += (thread_started ? 1 : 0);
+        }
+    }
+}
+
+// Runs num_jobs jobs on the threads of the pool, the calling thread included, and returns once they are all done.
+// Only one thread can post jobs to a pool.
+void workerPoolRun(workerPool_t *const p_pool, workerPoolJobFn_t *const p_job_fn, void *const p_ctx,
+                   const int num_jobs)
+{
+    if (p_pool->num_threads > 1)
+    {
+        SDL_LockMutex(p_pool->p_lock);
+        p_pool->p_job_fn = p_job_fn;
+        p_pool->p_job_ctx = p_ctx;
+        p_pool->num_jobs = num_jobs;
+        p_pool->next_job = 0;
+        p_pool->num_jobs_done = 0;
+        SDL_CondBroadcast(p_pool->p_jobs_posted);
+
+        workerPoolRunJobs(p_pool, 0);
+
+        // The last jobs may still be running on other threads
+        while (p_pool->num_jobs_done < p_pool->num_jobs)
+        {
+            SDL_CondWait(p_pool->p_batch_done, p_pool->p_lock);
+        }
+        SDL_UnlockMutex(p_pool->p_lock);
+    }
+    else
+    {
+        for (int job_idx = 0; job_idx < num_jobs; job_idx++)
+        {
+            p_job_fn(p_ctx, job_idx, 0);
+        }
+    }
+}
+
+// Gets the number of threads jobs are run on, including the thread posting them. Can be less than
+// what the pool was initialized with, if threads could not be started.
+int workerPoolNumThreads(const workerPool_t *const p_pool)
+{
+    return p_pool->num_threads;
+}
+
+// Stops the threads of the pool, once they are done with the jobs they are running
+void workerPoolDestroy(workerPool_t *const p_pool)
+{
+    if (p_pool->p_lock != NULL)
+    {
+        SDL_LockMutex(p_pool->p_lock);
+        p_pool->shutting_down = true;
+        SDL_CondBroadcast(p_pool->p_jobs_posted);
+        SDL_UnlockMutex(p_pool->p_lock);
+    }
+
+    for (int idx = 1; idx < p_pool->num_threads; idx++)
+    {
+        SDL_WaitThread(p_pool->threads[idx].p_thread, NULL);
+    }
+
+    if (p_pool->p_batch_done != NULL)
+    {
+        SDL_DestroyCond(p_pool->p_batch_done);
+    }
+    if (p_pool->p_jobs_posted != NULL)
+    {
+        SDL_DestroyCond(p_pool->p_jobs_posted);
+    }
+    if (p_pool->p_lock != NULL)
+    {
+        SDL_DestroyMutex(p_pool->p_lock);
+    }
+
+    memset(p_pool, 0, sizeof(workerPool_t));
+}
+
+/* *************************   Private Functions   ************************ */
+
+// Main loop of each thread of the pool, waits for jobs and runs them until the pool shuts down
+static int SDLCALL workerPoolThreadMain(void *p_data)
+{
+    const workerPoolThread_t *const p_thread = (const workerPoolThread_t *)p_data;
+    workerPool_t *const p_pool = p_thread->p_pool;
+
+    SDL_LockMutex(p_pool->p_lock);
+    while (!p_pool->shutting_down)
+    {
+        if (p_pool->next_job < p_pool->num_jobs)
+        {
+            workerPoolRunJobs(p_pool, p_thread->worker_idx);
+        }
+        else
+        {
+            SDL_CondWait(p_pool->p_jobs_posted, p_pool->p_lock);
+        }
+    }
+    SDL_UnlockMutex(p_pool->p_lock);
+
+    return 0;
+}
+
+// Takes jobs of the current batch and runs them until there are none left. Called with the lock held, which is
+// released while each job runs.
+static void workerPoolRunJobs(workerPool_t *const p_pool, const int worker_idx)
+{
+    while (p_pool->next_job < p_pool->num_jobs)
+    {
+        const int job_idx = p_pool->next_job++;
+        workerPoolJobFn_t *const p_job_fn = p_pool->p_job_fn;
+        void *const p_job_ctx = p_pool->p_job_ctx;
+
+        SDL_UnlockMutex(p_pool->p_lock);
+        p_job_fn(p_job_ctx, job_idx, worker_idx);
+        SDL_LockMutex(p_pool->p_lock);
+
+        p_pool->num_jobs_done++;
+        if (p_pool->num_jobs_done == p_pool->num_jobs)
+        {
+            SDL_CondSignal(p_pool->p_batch_done);
+        }
+    }
+}
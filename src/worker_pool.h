@@ -0,0 +1,97 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//  worker_pool.h
+//
+//  Worker Pool
+//
+//  Fixed set of threads that are started once and then handed batches of jobs, instead of threads
+//  being created and joined every time there is work to share. A batch is a number of jobs and a
+//  function to run each one with; idle threads take the next job of the batch until there are none
+//  left, so uneven jobs still balance out. The thread posting the batch runs jobs too, and waits for
+//  the whole batch to be done before returning.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+/* ***************************    Includes     **************************** */
+
+#include <stdbool.h>
+
+#include <SDL.h>
+
+/* ***************************   Definitions   **************************** */
+
+// Most threads a pool can have, including the thread posting the jobs
+#define WORKER_POOL_MAX_THREADS     16
+
+/* ****************************   Structures   **************************** */
+
+// Runs a single job of a batch
+// job_idx: Index of the job in the batch, from 0 to num_jobs - 1
+// worker_idx: Index of the thread running the job, from 0 to num_threads - 1. The thread that posted the
+//             batch is 0. No two jobs run at the same time on the same worker, so it can index per-thread state.
+typedef void (workerPoolJobFn_t)(void *p_ctx, const int job_idx, const int worker_idx);
+
+typedef struct WorkerPool workerPool_t;
+
+// Thread of a pool, and the index it runs jobs as
+typedef struct
+{
+    workerPool_t *p_pool;
+    SDL_Thread *p_thread;
+    int worker_idx;
+} workerPoolThread_t;
+
+// All of the members are private to the module.
+// NOTE: The threads point back to the pool, it must not be moved once initialized
+struct WorkerPool
+{
+    workerPoolThread_t threads[WORKER_POOL_MAX_THREADS]; // threads[0] is the thread posting the jobs, never started
+    int num_threads;
+
+    SDL_mutex *p_lock;
+    SDL_cond *p_jobs_posted;    // Signaled when a batch is posted, and when the pool is shutting down
+    SDL_cond *p_batch_done;     // Signaled when the last job of a batch is done
+
+    // Current batch
+    workerPoolJobFn_t *p_job_fn;
+    void *p_job_ctx;
+    int num_jobs;
+    int next_job;
+    int num_jobs_done;
+    bool shutting_down;
+};
+
+/* ***********************   Function Prototypes   ************************ */
+
+void workerPoolInit(workerPool_t *const p_pool, const int num_threads);
+void workerPoolRun(workerPool_t *const p_pool, workerPoolJobFn_t *const p_job_fn, void *const p_ctx,
+                   const int num_jobs);
+int workerPoolNumThreads(const workerPool_t *const p_pool);
+void workerPoolDestroy(workerPool_t *const p_pool);
+
+#endif /* WORKER_POOL_H */
@@ -0,0 +1,505 @@
+#!/usr/bin/env python3
+##############################################################################
+#
+#  json_codegen.py
+#
+#  JSON Deserializer Code Generator
+#
+#  Compiles a schema description file into a C struct, the matching jsonKeyValue_t table
+#  (used by the generic, table-driven deserializer) and a specialised deserializer function.
+#  The specialised function walks the tokens of an object once, dispatching on the key hashes
+#  computed by jsmn, with the key comparisons and value conversions written out for each key.
+#
+#  Usage: json_codegen.py <schema file> <output directory>
+#
+#  Schema file format, one statement per line, '#' starts a comment:
+#
+#      struct      <name of the C struct to generate>
+#      function    <name of the deserializer function to generate>
+#      table       <name of the jsonKeyValue_t table to generate>
+#      output      <base name of the .c/.h files to generate>
+#
+#      <type>      <struct member>     <dot notation key path>     [optional]
+#
+#  Keys are required unless marked optional. Objects stop being walked once every key in them has been found.
+#  Supported types: str_ptr (jsonStr_t), str:<buffer size> (char array), bool, float,
+#  int8, int16, int32, int64, uint8, uint16, uint32
+#
+# The MIT License (MIT)
+#
+# Copyright (c) 2020, Thomas Bresson
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+##############################################################################
+
+import os
+import re
+import sys
+
+# Must match JSMN_HASH_INIT and JSMN_HASH_STEP in jsmn.h
+JSMN_HASH_INIT = 2166136261
+JSMN_HASH_PRIME = 16777619
+
+# type: (C type, jsonCPrimitiveType_t, jsmntype_t)
+TYPES = {
+    'str_ptr': ('jsonStr_t', 'E_JSON_C_STR_PTR', 'JSMN_STRING'),
+    'str':     ('char', 'E_JSON_C_NONE', 'JSMN_STRING'),
+    'bool':    ('bool', 'E_JSON_C_BOOL', 'JSMN_PRIMITIVE'),
+    'float':   ('float', 'E_JSON_C_FLOAT', 'JSMN_PRIMITIVE'),
+    'int8':    ('int8_t', 'E_JSON_C_INT8', 'JSMN_PRIMITIVE'),
+    'int16':   ('int16_t', 'E_JSON_C_INT16', 'JSMN_PRIMITIVE'),
+    'int32':   ('int32_t', 'E_JSON_C_INT32', 'JSMN_PRIMITIVE'),
+    'int64':   ('int64_t', 'E_JSON_C_INT64', 'JSMN_PRIMITIVE'),
+    'uint8':   ('uint8_t', 'E_JSON_C_UINT8', 'JSMN_PRIMITIVE'),
+    'uint16':  ('uint16_t', 'E_JSON_C_UINT16', 'JSMN_PRIMITIVE'),
+    'uint32':  ('uint32_t', 'E_JSON_C_UINT32', 'JSMN_PRIMITIVE'),
+}
+
+LICENSE = """//
+// The MIT License (MIT)
+//
+// Copyright (c) 2020, Thomas Bresson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////
+"""
+
+
+class Field:
+    def __init__(self, idx, type_str, member, key_path, optional):
+        self.idx = idx
+        self.optional = optional
+        self.type_name = type_str.split(':')[0]
+        self.buff_size = int(type_str.split(':')[1]) if ':' in type_str else 0
+        self.member = member
+        self.key_path = key_path
+        self.c_type, self.json_c_type, self.tok_type = TYPES[self.type_name]
+
+
+class Node:
+    """Node of the key path tree, one per distinct key path prefix"""
+
+    def __init__(self, key, path):
+        self.key = key
+        self.path = path
+        self.children = []
+        self.field = None
+
+    def child(self, key):
+        for node in self.children:
+            if node.key == key:
+                return node
+        node = Node(key, self.path + [key])
+        self.children.append(node)
+        return node
+
+
+def jsmn_hash(key):
+    hash_value = JSMN_HASH_INIT
+    for byte in key.encode('utf-8'):
+        hash_value = ((hash_value ^ byte) * JSMN_HASH_PRIME) & 0xFFFFFFFF
+    return hash_value
+
+
+def fail(schema_path, line_num, msg):
+    sys.exit('%s:%d: error: %s' % (schema_path, line_num, msg))
+
+
+def parse_schema(schema_path):
+    settings = {}
+    fields = []
+    with open(schema_path, 'r') as schema_file:
+        for line_num, line in enumerate(schema_file, 1):
+            words = line.split('#', 1)[0].split()
+            if not words:
+                continue
+
+            if words[0] in ('struct', 'function', 'table', 'output'):
+                if len(words) != 2:
+                    fail(schema_path, line_num, '%s takes one name' % words[0])
+                settings[words[0]] = words[1]
+            elif words[0].split(':')[0] in TYPES:
+                if (len(words) not in (3, 4)) or ((len(words) == 4) and (words[3] != 'optional')):
+                    fail(schema_path, line_num, 'expected <type> <member> <key path> [optional]')
+                if (words[0] == 'str') or (words[0].startswith('str:') and not re.match(r'^str:\d+$', words[0])):
+                    fail(schema_path, line_num, 'str needs a buffer size, i.e. str:32')
+                fields.append(Field(len(fields), words[0], words[1], words[2], len(words) == 4))
+            else:
+                fail(schema_path, line_num, 'unknown statement or type "%s"' % words[0])
+
+    for name in ('struct', 'function', 'table', 'output'):
+        if name not in settings:
+            fail(schema_path, 0, 'missing "%s"' % name)
+    if not fields:
+        fail(schema_path, 0, 'no fields')
+
+    return settings, fields
+
+
+def build_tree(schema_path, fields):
+    root = Node(None, [])
+    for field in fields:
+        node = root
+        for key in field.key_path.split('.'):
+            node = node.child(key)
+        if node.field is not None:
+            fail(schema_path, 0, 'key path %s listed twice' % field.key_path)
+        if node.children:
+            fail(schema_path, 0, 'key path %s is both a value and an object' % field.key_path)
+        node.field = field
+    for node in walk(root):
+        if node.field is not None and node.children:
+            fail(schema_path, 0, 'key path %s is both a value and an object' % '.'.join(node.path))
+    return root
+
+
+def walk(node):
+    yield node
+    for child in node.children:
+        yield from walk(child)
+
+
+def count_fields(node):
+    return sum(1 for child in walk(node) if child.field is not None)
+
+
+def object_fn_name(settings, node):
+    # The root object is handled by the public function, the others by a private one per object
+    if not node.path:
+        return settings['function'] + 'Object'
+    words = re.split(r'[^0-9A-Za-z]+', ' '.join(node.path))
+    return settings['function'] + ''.join(word[:1].upper() + word[1:] for word in words if word)
+
+
+def c_str(text):
+    return '"' + text.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def emit_conversion(field, out, indent):
+    member = 'p_obj->%s' % field.member
+    pad = ' ' * indent
+    if field.type_name == 'str_ptr':
+        out.append(pad + '%s = jsonStringCacheGet(p_string_cache, p_json_buff, p_value);' % member)
+    elif field.type_name == 'str':
+        out.append(pad + 'jsonStringCopy(&p_json_buff[p_value->start], (p_value->end - p_value->start), %s, ARRAY_SIZE(%s));'
+                   % (member, member))
+    elif field.type_name == 'bool':
+        out.append(pad + "%s = (p_json_buff[p_value->start] == 't');" % member)
+    elif field.type_name == 'float':
+        out.append(pad + 'jsonNumberParseFloat(&p_json_buff[p_value->start], (p_value->end - p_value->start), &%s);' % member)
+    elif field.type_name.startswith('uint'):
+        # null and values out of range end up as 0 and the largest value respectively
+        width = field.type_name[4:]
+        out.append(pad + 'uint64_t value = 0;')
+        out.append(pad + 'jsonNumberParseUint(&p_json_buff[p_value->start], (p_value->end - p_value->start), UINT%s_MAX, &value);'
+                   % width)
+        out.append(pad + '%s = (%s)value;' % (member, field.c_type))
+    else:
+        width = field.type_name[3:]
+        out.append(pad + 'int64_t value = 0;')
+        out.append(pad + 'jsonNumberParseInt(&p_json_buff[p_value->start], (p_value->end - p_value->start), INT%s_MIN, INT%s_MAX,'
+                   % (width, width))
+        out.append(pad + '                   &value);')
+        out.append(pad + '%s = (%s)value;' % (member, field.c_type))
+
+
+def emit_object_fn(settings, node, out):
+    struct = settings['struct']
+    out.append('// Keys of "%s"' % ('.'.join(node.path) if node.path else '(root)'))
+    out.append('static int %s(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,' % object_fn_name(settings, node))
+    out.append('    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, %s *const p_obj,' % struct)
+    out.append('    bool *const p_found_keys, int *const p_num_found)')
+    out.append('{')
+    out.append('    const int num_keys = p_tokens[obj_tok_idx].size;')
+    out.append('    const int num_found_before = *p_num_found;')
+    out.append('    bool all_found = false;')
+    out.append('')
+    out.append('    int tok_idx = (obj_tok_idx + 1);')
+    out.append('    for (int idx = 0; (idx < num_keys) && ((tok_idx + 1) < num_tokens) && !all_found; idx++)')
+    out.append('    {')
+    out.append('        const jsmntok_t *const p_key = &p_tokens[tok_idx];')
+    out.append('        const jsmntok_t *const p_value = &p_tokens[tok_idx + 1];')
+    out.append('        const int key_len = (p_key->end - p_key->start);')
+    out.append('        int next_tok_idx = -1;')
+    out.append('')
+    out.append('        switch (p_key->hash)')
+    out.append('        {')
+
+    # Keys with the same hash share a case
+    by_hash = {}
+    for child in node.children:
+        by_hash.setdefault(jsmn_hash(child.key), []).append(child)
+
+    for hash_value in sorted(by_hash):
+        children = by_hash[hash_value]
+        out.append('            case 0x%08Xu: // %s' % (hash_value, ', '.join(c_str(c.key) for c in children)))
+        for child_num, child in enumerate(children):
+            key_len = len(child.key.encode('utf-8'))
+            tok_type = child.field.tok_type if child.field is not None else 'JSMN_OBJECT'
+            out.append('                %sif ((key_len == %d) && (memcmp(&p_json_buff[p_key->start], %s, %d) == 0) &&'
+                       % ('else ' if child_num > 0 else '', key_len, c_str(child.key), key_len))
+            out.append('                    (p_value->type == %s))' % tok_type)
+            out.append('                {')
+            if child.field is not None:
+                emit_conversion(child.field, out, 20)
+                out.append('                    JSON_GEN_FOUND(%d);' % child.field.idx)
+            else:
+                out.append('                    next_tok_idx = %s(p_tokens, num_tokens, (tok_idx + 1), p_json_buff, p_string_cache,'
+                           % object_fn_name(settings, child))
+                out.append('                        p_obj, p_found_keys, p_num_found);')
+            out.append('                }')
+        out.append('                break;')
+        out.append('')
+
+    out.append('            default:')
+    out.append('                break;')
+    out.append('        }')
+    out.append('')
+    out.append('        // Values that were not walked into are stepped over')
+    out.append('        tok_idx = (next_tok_idx != -1) ? next_tok_idx : jsonGenSkipValue(p_tokens, num_tokens, (tok_idx + 1));')
+    out.append('        all_found = ((*p_num_found - num_found_before) >= %d);' % count_fields(node))
+    out.append('    }')
+    out.append('')
+    out.append('    if (all_found && (tok_idx < num_tokens) && (p_tokens[tok_idx].start < p_tokens[obj_tok_idx].end))')
+    out.append('    {')
+    out.append('        // Step over the keys that were not looked at')
+    out.append('        tok_idx = jsonGenSkipValue(p_tokens, num_tokens, obj_tok_idx);')
+    out.append('    }')
+    out.append('')
+    out.append('    return tok_idx;')
+    out.append('}')
+    out.append('')
+
+
+def generate_header(settings, fields, schema_name):
+    guard = settings['output'].upper() + '_H'
+    num_keys_define = settings['output'].upper() + '_NUM_KEYS'
+    out = []
+    out.append('//////////////////////////////////////////////////////////////////////////////')
+    out.append('//')
+    out.append('//  %s.h' % settings['output'])
+    out.append('//')
+    out.append('//  GENERATED by tools/json_codegen.py from %s, DO NOT EDIT' % schema_name)
+    out.append(LICENSE)
+    out.append('#ifndef %s' % guard)
+    out.append('#define %s' % guard)
+    out.append('')
+    out.append('/* ***************************    Includes     **************************** */')
+    out.append('')
+    out.append('#include <stdbool.h>')
+    out.append('#include <stdint.h>')
+    out.append('')
+    out.append('#include "json_deserialization.h"')
+    out.append('')
+    out.append('/* ***************************   Definitions   **************************** */')
+    out.append('')
+    out.append('// Number of entries in %s' % settings['table'])
+    out.append('#define %s %d' % (num_keys_define, len(fields)))
+    out.append('')
+    out.append('/* ****************************   Structures   **************************** */')
+    out.append('')
+    out.append('typedef struct')
+    out.append('{')
+    for field in fields:
+        array = '[%d]' % field.buff_size if field.buff_size else ''
+        decl = '    %s %s%s;' % (field.c_type, field.member, array)
+        out.append('%s // %s' % (decl.ljust(40), field.key_path))
+    out.append('} %s;' % settings['struct'])
+    out.append('')
+    out.append('/* ***********************   Function Prototypes   ************************ */')
+    out.append('')
+    out.append('int %s(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,' % settings['function'])
+    out.append('    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, void *const p_data,')
+    out.append('    bool *const p_found_keys, int *const p_num_found);')
+    out.append('')
+    out.append('/* ***********************   File Scope Variables   *********************** */')
+    out.append('')
+    out.append('// Table for the generic deserializer, describing the same keys as %s()' % settings['function'])
+    out.append('extern const jsonKeyValue_t %s[%s];' % (settings['table'], num_keys_define))
+    out.append('')
+    out.append('#endif /* %s */' % guard)
+    return '\n'.join(out) + '\n'
+
+
+def generate_source(settings, fields, root, schema_name):
+    num_keys_define = settings['output'].upper() + '_NUM_KEYS'
+    out = []
+    out.append('//////////////////////////////////////////////////////////////////////////////')
+    out.append('//')
+    out.append('//  %s.c' % settings['output'])
+    out.append('//')
+    out.append('//  GENERATED by tools/json_codegen.py from %s, DO NOT EDIT' % schema_name)
+    out.append(LICENSE)
+    out.append('/* ***************************    Includes     **************************** */')
+    out.append('')
+    out.append('// Standard Includes')
+    out.append('#include <stddef.h>')
+    out.append('#include <stdint.h>')
+    out.append('#include <string.h>')
+    out.append('')
+    out.append('// Project Includes')
+    out.append('#include "utility.h"')
+    out.append('#include "json_number.h"')
+    out.append('#include "json_string.h"')
+    out.append('')
+    out.append('// Module Includes')
+    out.append('#include "%s.h"' % settings['output'])
+    out.append('')
+    out.append('/* ***************************   Definitions   **************************** */')
+    out.append('')
+    out.append('// Marks a key of the table as found')
+    out.append('#define JSON_GEN_FOUND(key_idx)                 \\')
+    out.append('    do                                          \\')
+    out.append('    {                                           \\')
+    out.append('        if (p_found_keys != NULL)               \\')
+    out.append('        {                                       \\')
+    out.append('            p_found_keys[(key_idx)] = true;     \\')
+    out.append('        }                                       \\')
+    out.append('        (*p_num_found)++;                       \\')
+    out.append('    } while (0)')
+    out.append('')
+    out.append('/* ***********************   Function Prototypes   ************************ */')
+    out.append('')
+    objects = [node for node in walk(root) if node.field is None]
+    struct = settings['struct']
+    for node in objects:
+        out.append('static int %s(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,' % object_fn_name(settings, node))
+        out.append('    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, %s *const p_obj,' % struct)
+        out.append('    bool *const p_found_keys, int *const p_num_found);')
+    out.append('static int jsonGenSkipValue(const jsmntok_t *const p_tokens, const int num_tokens, const int tok_idx);')
+    out.append('')
+    out.append('/* ***********************   File Scope Variables   *********************** */')
+    out.append('')
+    out.append('const jsonKeyValue_t %s[%s] =' % (settings['table'], num_keys_define))
+    out.append('    {')
+    for field in fields:
+        out.append('        {.key_str = %s,' % c_str(field.key_path))
+        out.append('         .c_type = %s,' % field.json_c_type)
+        out.append('         .value_tok_type = %s,' % field.tok_type)
+        if field.optional:
+            out.append('         .optional = true,')
+        out.append('         .struct_member_offset = offsetof(%s, %s),' % (struct, field.member))
+        out.append('         .struct_member_size = MEMBER_SIZE(%s, %s)},' % (struct, field.member))
+    out.append('};')
+    out.append('')
+    out.append('/* ****************************   BEGIN CODE   **************************** */')
+    out.append('')
+    out.append('/* *************************   Public  Functions   ************************ */')
+    out.append('')
+    out.append('// Deserializes the object at obj_tok_idx into the %s at p_data, walking its tokens once and' % struct)
+    out.append('// stopping as soon as every key has been found.')
+    out.append('// p_string_cache[in]: Cache of the token arena p_tokens come from, decodes the escaped strings.')
+    out.append('// p_found_keys[out]: Optional, can be NULL. Set to true for every entry of %s deserialized.' % settings['table'])
+    out.append('// p_num_found[in/out]: Incremented for every key deserialized')
+    out.append('// Returns the index of the token following the object (and everything inside of it).')
+    out.append('int %s(const jsmntok_t *const p_tokens, const int num_tokens, const int obj_tok_idx,' % settings['function'])
+    out.append('    const char *const p_json_buff, jsonStringCache_t *const p_string_cache, void *const p_data,')
+    out.append('    bool *const p_found_keys, int *const p_num_found)')
+    out.append('{')
+    out.append('    int next_tok_idx = (obj_tok_idx + 1);')
+    out.append('    if (p_tokens[obj_tok_idx].type == JSMN_OBJECT)')
+    out.append('    {')
+    out.append('        next_tok_idx = %s(p_tokens, num_tokens, obj_tok_idx, p_json_buff, p_string_cache,' % object_fn_name(settings, root))
+    out.append('            (%s *)p_data, p_found_keys, p_num_found);' % struct)
+    out.append('    }')
+    out.append('')
+    out.append('    return next_tok_idx;')
+    out.append('}')
+    out.append('')
+    out.append('/* *************************   Private Functions   ************************ */')
+    out.append('')
+    for node in objects:
+        emit_object_fn(settings, node, out)
+
+    out.append('''// Gets the index of the token following a value and everything inside of it
+static int jsonGenSkipValue(const jsmntok_t *const p_tokens, const int num_tokens, const int tok_idx)
+{
+    const int value_end = p_tokens[tok_idx].end;
+    int next_tok_idx = (tok_idx + 1);
+
+    if ((next_tok_idx < num_tokens) && (p_tokens[next_tok_idx].start < value_end))
+    {
+        // Tokens are in the order they start at, the first one past the value is found with a binary search.
+        // Every token takes up at least a byte, so there are no more tokens in the value than it has bytes.
+        const int max_tok_idx = (next_tok_idx + (value_end - p_tokens[tok_idx].start));
+        int high_idx = (max_tok_idx < num_tokens) ? max_tok_idx : num_tokens;
+        while (next_tok_idx < high_idx)
+        {
+            const int mid_idx = next_tok_idx + ((high_idx - next_tok_idx) / 2);
+            if (p_tokens[mid_idx].start < value_end)
+            {
+                next_tok_idx = (mid_idx + 1);
+            }
+            else
+            {
+                high_idx = mid_idx;
+            }
+        }
+    }
+
+    return next_tok_idx;
+}''')
+    return '\n'.join(out) + '\n'
+
+
+def write_if_changed(path, text):
+    # Leaving unchanged files alone keeps the build from recompiling them
+    if os.path.exists(path):
+        with open(path, 'r', newline='') as existing_file:
+            if existing_file.read() == text:
+                return
+    with open(path, 'w', newline='\n') as out_file:
+        out_file.write(text)
+
+
+def main(argv):
+    if len(argv) != 3:
+        sys.exit('Usage: %s <schema file> <output directory>' % os.path.basename(argv[0]))
+
+    schema_path, out_dir = argv[1], argv[2]
+    settings, fields = parse_schema(schema_path)
+    root = build_tree(schema_path, fields)
+
+    # Paths in the generated comments are kept relative, so the output does not depend on where it was built
+    schema_name = os.path.basename(schema_path)
+    os.makedirs(out_dir, exist_ok=True)
+    write_if_changed(os.path.join(out_dir, settings['output'] + '.h'), generate_header(settings, fields, schema_name))
+    write_if_changed(os.path.join(out_dir, settings['output'] + '.c'), generate_source(settings, fields, root, schema_name))
+
+
+if __name__ == '__main__':
+    main(sys.argv)